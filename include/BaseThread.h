@@ -7,6 +7,14 @@
  * `Start()` and `Stop()`, executing a setup routine once and then repeatedly
  * calling `Step()` until a stop is requested.  Derived classes implement the
  * virtual Setup, Step and Exit hooks to provide their behavior.
+ *
+ * Allocation: the caller supplies the stack. With HF_RTOS_STATIC_ALLOCATION
+ * the task control block is embedded in the object as well, so creating a
+ * thread never touches the heap.
+ *
+ * Instrumentation: define HF_BASETHREAD_STEP_STATS to record per-thread
+ * Step() execution time and start jitter histograms (~1 KB per thread).
+ * Without it the hooks compile to nothing.
  * @todo Add @copyright line once project copyright wording is finalised.
  */
 
@@ -18,6 +26,11 @@
 #include "OsAbstraction.h"
 #include "OsUtility.h"
 #include "SignalSemaphore.h"
+#include "WakeTarget.h"
+#include "CpuUsage.h"
+#if defined(HF_BASETHREAD_STEP_STATS)
+#include "LatencyHistogram.h"
+#endif
 
 /**
  * @class BaseThread
@@ -31,6 +44,48 @@
 class BaseThread
 {
 public:
+    /**
+     * @brief How ThreadEntry paces successive Step() calls.
+     */
+    enum class ScheduleMode : uint8_t
+    {
+        Delay,      ///< Sleep for Step()'s return value after every Step() (default).
+        FixedRate,  ///< Step()'s return value is the period; wake on absolute deadlines.
+        EventDriven ///< Block until woken (see GetWakeTarget()); Step()'s return value is the
+                    ///< longest idle time in ms, or UINT32_MAX to wait for a wake only.
+    };
+
+    /**
+     * @brief Deadline counters published by ThreadEntry; see SetStepBudget().
+     */
+    struct DeadlineStats
+    {
+        uint32_t misses;                ///< Steps that exceeded the budget or the period.
+        uint32_t consecutiveMisses;     ///< Current run of back-to-back misses (0 after a step on time).
+        uint32_t maxConsecutiveMisses;  ///< Longest run of back-to-back misses.
+        uint32_t worstOverrunUs;        ///< Largest amount by which a step exceeded its budget or period.
+    };
+
+    /**
+     * @brief Details of one miss, passed to OnDeadlineMiss().
+     */
+    struct DeadlineMiss
+    {
+        uint32_t stepUs;                ///< Execution time of the Step() that missed.
+        uint32_t intervalUs;            ///< Start-to-start time since the previous Step(); 0 on the first step of a run.
+        uint32_t overrunUs;             ///< Amount by which the budget or period was exceeded (the larger of the two).
+        uint32_t consecutiveMisses;     ///< Misses in a row, including this one.
+    };
+
+    /**
+     * @brief What FixedRate does when Step() finishes after its next deadline.
+     */
+    enum class OverrunPolicy : uint8_t
+    {
+        Skip,       ///< Drop the missed periods and wait for the next deadline on the original grid.
+        CatchUp     ///< Run the missed Step() calls back-to-back until the schedule is met again.
+    };
+
     /**
      * @brief Construct a new Base Thread object.
      * @param threadName Name of the thread.
@@ -53,6 +108,10 @@ public:
     /**
      * @brief  The destructor de-initializes the singleton. It is not likely to be called in released products, but is
      * implemented to support unit testing
+     *
+     * On the POSIX backend the thread is deleted cooperatively: the destructor waits up to
+     * HF_RTOS_POSIX_DELETE_WAIT_MS for it to reach an os_* call. A Step() still busy outside os_* calls
+     * after that keeps running until its next one, so stop the thread first if Step() can run that long.
      * @return n/a
      */
     virtual ~BaseThread() noexcept;
@@ -114,7 +173,7 @@ public:
 
     bool IsSuspended() noexcept;
 
-    bool IsThreadCreated() noexcept { return osThreadCreated; }
+    bool IsThreadCreated() const noexcept { return osThreadCreated; }
     bool IsThreadStopRequested() noexcept { return stopThreadRequested; }
     bool IsSetupComplete() const noexcept { return setupComplete; }
     bool IsThreadRunning() const noexcept {
@@ -154,12 +213,37 @@ public:
      *
      * This function stops the execution of the thread.
      * The thread can be resumed later by calling service_start().  The base class
-     *  simple sets the variable indicating the thread should stop.
+     *  sets the variable indicating the thread should stop and wakes the thread
+     *  from its step delay, so the stop does not wait for the delay to expire.
      *
      * @return True if the thread was signaled to stop, false otherwise.
      */
     bool Stop() noexcept;
 
+    /**
+     * @brief Cut the current step delay short so the next Step() runs now.
+     *
+     * A wake issued while Step() is executing ends the following delay
+     * immediately. In FixedRate mode the extra Step() does not move the
+     * schedule. Safe from any task.
+     *
+     * @return True if the wake was signalled, false if the thread is not created.
+     */
+    bool Wake() noexcept;
+
+    /**
+     * @brief Handle that producers use to wake this thread, e.g.
+     *        `queue.SetWakeTarget(worker.GetWakeTarget())`.
+     *
+     * Signalling it is equivalent to Wake(). Meant for EventDriven mode, where
+     * Step() then runs as soon as a message, flag or snapshot arrives. A
+     * signal raised while Step() runs is latched, so Step() should consume
+     * all pending work before returning.
+     *
+     * @return The target, or an empty one if the thread cannot be initialized.
+     */
+    WakeTarget GetWakeTarget() noexcept;
+
     /**
      * @brief Setup the thread.
      *
@@ -182,6 +266,15 @@ public:
      */
     virtual uint32_t Step() noexcept = 0;
 
+    /**
+     * @brief Called on the thread, right after a Step() that missed its budget
+     *        or period (see SetStepBudget()). Default does nothing.
+     *
+     * Runs inside the control loop, so keep it short: log, raise a fault flag
+     * or shed load.
+     */
+    virtual void OnDeadlineMiss(const DeadlineMiss& miss) noexcept { (void)miss; }
+
     /**
      * @brief Cleanup code that exists once the thread step sequence is stopped.
      *   The cleanup function should generally clear the setup flag to ensure the thread
@@ -218,6 +311,109 @@ public:
      */
     bool StopThreadAndWaitToVerify(uint32_t stopTimeoutMsec);
 
+    /**
+     * @brief Select how Step() calls are paced. Takes effect on the next Start().
+     *
+     * In FixedRate mode each Step() is released on an absolute tick deadline:
+     * the thread waits on its event group for the ticks left until that
+     * deadline, so the cadence does not drift with the execution time of
+     * Step(), and Wake() or Stop() still end the wait early. The period is
+     * Step()'s return value rounded down to whole ticks (minimum one tick);
+     * a 1 kHz loop therefore needs a 1 kHz tick rate.
+     *
+     * @param mode   Delay (default), FixedRate, or EventDriven. In EventDriven
+     *               mode the thread blocks until woken, and Step()'s return
+     *               value is the longest idle time in ms; UINT32_MAX waits
+     *               for a wake only.
+     * @param policy Overrun handling in FixedRate mode.
+     * @return False if the thread is running, true otherwise.
+     */
+    bool SetScheduleMode(ScheduleMode mode, OverrunPolicy policy = OverrunPolicy::Skip) noexcept;
+
+    ScheduleMode GetScheduleMode() const noexcept { return scheduleMode; }
+    OverrunPolicy GetOverrunPolicy() const noexcept { return overrunPolicy; }
+
+    /**
+     * @brief Number of FixedRate periods whose Step() finished after the next
+     *        deadline. Never reset.
+     */
+    uint32_t GetOverrunCount() const noexcept { return overrunCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief [BLOCKING] Wait until the thread reports running, without polling.
+     *
+     * @param timeoutMsec Maximum wait in milliseconds; UINT32_MAX waits forever.
+     * @return True if the thread is running, false on timeout.
+     */
+    bool WaitUntilRunning(uint32_t timeoutMsec) noexcept;
+
+    /**
+     * @brief [BLOCKING] Wait until the thread reports stopped, without polling.
+     *
+     * @param timeoutMsec Maximum wait in milliseconds; UINT32_MAX waits forever.
+     * @return True if the thread is stopped, false on timeout.
+     */
+    bool WaitUntilStopped(uint32_t timeoutMsec) noexcept;
+
+    /**
+     * @brief [BLOCKING] Wait until the thread is running and its Setup() has
+     *        returned, without polling.
+     *
+     * @param timeoutMsec Maximum wait in milliseconds; UINT32_MAX waits forever.
+     * @return True if the thread is ready, false on timeout.
+     */
+    bool WaitUntilReady(uint32_t timeoutMsec) noexcept;
+
+    /**
+     * @brief Declare a per-step timing budget. Takes effect on the next Start().
+     *
+     * After every Step() the thread checks its execution time against
+     * @p budgetUs and the time since the previous Step() started against
+     * @p periodUs. A step exceeding either is a deadline miss: it is counted
+     * in GetDeadlineStats() and OnDeadlineMiss() is called on the thread.
+     * Pass 0 to disable a check; with both 0 (the default) no timing is done.
+     *
+     * @param budgetUs Maximum Step() execution time in microseconds.
+     * @param periodUs Maximum start-to-start interval in microseconds. In Delay
+     *                 mode the interval includes the step delay.
+     * @return False if the thread is running, true otherwise.
+     */
+    bool SetStepBudget(uint32_t budgetUs, uint32_t periodUs = 0) noexcept;
+
+    /**
+     * @brief Read the deadline counters. Lock-free; safe from any task.
+     */
+    DeadlineStats GetDeadlineStats() const noexcept;
+
+    /**
+     * @brief Zero the deadline counters.
+     */
+    void ResetDeadlineStats() noexcept;
+
+#if defined(HF_BASETHREAD_STEP_STATS)
+    /**
+     * @brief Execution time of each Step() call, in microseconds.
+     */
+    const LatencyHistogram& GetStepTimeHistogram() const noexcept { return stepTimeHistogram; }
+
+    /**
+     * @brief How late each Step() started compared with the time requested by
+     *        the previous Step(): end of the previous step + its delay, or start
+     *        of the previous step + the period in FixedRate mode. Early starts
+     *        (Wake()) count as zero.
+     */
+    const LatencyHistogram& GetStartJitterHistogram() const noexcept { return startJitterHistogram; }
+
+    /**
+     * @brief Clear both Step() histograms.
+     */
+    void ResetStepStats() noexcept
+    {
+        stepTimeHistogram.Reset();
+        startJitterHistogram.Reset();
+    }
+#endif
+
     /**
      * @brief Get the minimum remaining stack of the task.
      */
@@ -228,6 +424,50 @@ public:
      */
     bool ChangePriority(uint32_t newPriority) noexcept;
 
+    /**
+     * @brief Priority the thread was created with or last changed to.
+     */
+    uint32_t GetPriority() const noexcept { return threadPriority.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Core the thread is pinned to; -1 for no affinity.
+     */
+    int GetCoreId() const noexcept { return threadCoreId.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Choose the core this thread runs on (< 0: no affinity).
+     *
+     * Before the thread is created this overrides the `core_id` later passed to
+     * CreateBaseThread(). Afterwards it re-pins the running task, which needs
+     * backend support (see os_thread_affinity_set()).
+     *
+     * @return False if the core is invalid or the backend cannot re-pin.
+     */
+    bool SetCoreAffinity(int core) noexcept;
+
+    /**
+     * @brief Number of Step() calls since construction. Lock-free.
+     */
+    uint32_t GetStepCount() const noexcept { return stepCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief os_time_get() tick at the start of the latest Step(); 0 before the first. Lock-free.
+     */
+    uint32_t GetLastStepTick() const noexcept { return lastStepTick.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Feed this thread's CPU-time counter into its usage window. Call at a
+     *        fixed period from one task (once per second for the 1 s / 10 s windows). O(1).
+     * @param nowUs Low 32 bits of os_time_get_us().
+     * @return False if the thread is not created or the backend cannot measure CPU time.
+     */
+    bool SampleCpuUsage(uint32_t nowUs) noexcept;
+
+    /**
+     * @brief CPU share in permille of one core as of the latest SampleCpuUsage(). Lock-free.
+     */
+    CpuUsageWindow::Usage GetCpuUsage() const noexcept { return cpuUsage.Get(); }
+
 
 protected:
 
@@ -296,12 +536,20 @@ protected:
     /**
      * @brief Mark the setup as complete.
      */
-    void MarkSetupComplete() noexcept { setupComplete = true; }
+    void MarkSetupComplete() noexcept
+    {
+        setupComplete = true;
+        PublishReadyState(true);
+    }
 
     /**
      * @brief Clear the setup completion flag.
      */
-    void ClearSetupComplete() noexcept { setupComplete = false; }
+    void ClearSetupComplete() noexcept
+    {
+        setupComplete = false;
+        PublishReadyState(false);
+    }
 
     /**
      * @brief Mark the cleanup as complete.
@@ -314,14 +562,22 @@ protected:
     void ClearCleanupComplete() noexcept { cleanupComplete = false; }
 
     /**
-     * @brief Mark the thread as running.
+     * @brief Mark the thread as running and wake WaitUntilRunning() callers.
      */
-    void MarkThreadRunning() noexcept { threadRunning.store(true, std::memory_order_release); }
+    void MarkThreadRunning() noexcept
+    {
+        threadRunning.store(true, std::memory_order_release);
+        PublishRunState(true);
+    }
 
     /**
-     * @brief Mark the thread as not running.
+     * @brief Mark the thread as not running and wake WaitUntilStopped() callers.
      */
-    void ClearThreadRunning() noexcept { threadRunning.store(false, std::memory_order_release); }
+    void ClearThreadRunning() noexcept
+    {
+        threadRunning.store(false, std::memory_order_release);
+        PublishRunState(false);
+    }
 
     /**
      * @brief Indicate a request to stop the thread.
@@ -345,15 +601,91 @@ protected:
 
     bool initialized;
     OS_Thread osThread;
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_ThreadStorage osThreadStorage;  ///< TCB for osThread; the caller's stack buffer is used as-is.
+#else
+    os_thread_start_t osThreadStartContext;  ///< Entry trampoline context; avoids a heap block per thread.
+#endif
     const char *osThreadName;
     bool osThreadCreated;
     SignalSemaphore signalSemaphore;
     static constexpr char baseThreadStartSemaphoreBaseName[] = "BaseThreadStartSem-";
+#if HF_RTOS_NOTIFY_DEDICATED
+    /// The start signal always targets this object's own thread, so it is a
+    /// direct-to-task notification rather than a semaphore. Only when the
+    /// notification slot is dedicated: on slot 0 a Step() that uses
+    /// notifications could consume the start signal or be started by a stray give.
+    static constexpr SignalSemaphore::Mode startSignalMode = SignalSemaphore::Mode::TaskNotify;
+#else
+    static constexpr SignalSemaphore::Mode startSignalMode = SignalSemaphore::Mode::Semaphore;
+#endif
 
 private:
 
+    /**
+     * @brief FixedRate pacing: wait until the deadline after @p nextWake and
+     *        apply the overrun policy if it has already passed.
+     */
+    void SleepUntilNextPeriod(OS_Ulong& nextWake) noexcept;
+
+    /**
+     * @brief Sleep up to @p ticks, returning early on Wake() or Stop().
+     * @return True if woken early, false if the full delay elapsed.
+     */
+    bool WaitForWake(OS_Ulong ticks) noexcept;
+
+    /**
+     * @brief Create the per-thread event group on first use.
+     */
+    bool EnsureThreadEvents() noexcept;
+
+    /**
+     * @brief Mirror the running flag into the RUNNING / STOPPED event bits.
+     */
+    void PublishRunState(bool running) noexcept;
+
+    /**
+     * @brief Mirror the setup-complete flag into the READY event bit.
+     */
+    void PublishReadyState(bool ready) noexcept;
+
+    /**
+     * @brief Wait for @p stateBit (RUNNING, STOPPED or READY) without clearing it.
+     */
+    bool WaitForRunState(OS_Ulong stateBit, uint32_t timeoutMsec) noexcept;
+
+    /**
+     * @brief os_time_get_us() if any Step() timing is enabled, 0 otherwise.
+     */
+    uint64_t StepTimestamp() const noexcept;
+
+    /**
+     * @brief Apply the budget set by SetStepBudget() to the Step() that ran
+     *        from @p stepStartUs to @p stepEndUs.
+     */
+    void CheckStepDeadline(uint64_t stepStartUs, uint64_t stepEndUs) noexcept;
+
+    /**
+     * @brief Step() histogram hooks around each Step() call; empty unless
+     *        HF_BASETHREAD_STEP_STATS is defined.
+     */
+#if defined(HF_BASETHREAD_STEP_STATS)
+    void StepStatsBegin(uint64_t stepStartUs) noexcept;
+    void StepStatsEnd(uint64_t stepStartUs, uint64_t stepEndUs) noexcept;
+#else
+    void StepStatsBegin(uint64_t) noexcept {}
+    void StepStatsEnd(uint64_t, uint64_t) noexcept {}
+#endif
+
+    static constexpr OS_Ulong kThreadWakeBit    = 1U << 0;  ///< Set by Wake() / Stop(); cleared by the step delay.
+    static constexpr OS_Ulong kThreadRunningBit = 1U << 1;  ///< Set while IsThreadRunning().
+    static constexpr OS_Ulong kThreadStoppedBit = 1U << 2;  ///< Set while IsThreadStopped().
+    static constexpr OS_Ulong kThreadReadyBit   = 1U << 3;  ///< Set from the end of Setup() until after Cleanup().
+
     uint32_t waitBeforeStep;
-    uint32_t minTimestampBeforeNextStep;
+    ScheduleMode scheduleMode;
+    OverrunPolicy overrunPolicy;
+    std::atomic<uint32_t> overrunCount;
 
     std::atomic<bool> threadRunning;
     std::atomic<bool> threadStepInDelay;
@@ -361,6 +693,33 @@ private:
 	std::atomic<bool> cleanupComplete;
 	std::atomic<bool> stopThreadRequested;
 
+    OS_EventGroup threadEvents;  ///< Per-thread wake object for the step delay.
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_EventGroupStorage threadEventsStorage;
+#endif
+    bool threadEventsCreated;
+
+    uint32_t stepBudgetUs;
+    uint32_t stepPeriodUs;
+    uint64_t lastStepStartUs;  ///< Start of the previous Step(); 0 before the first Step() of a run.
+    std::atomic<uint32_t> stepCount;
+    std::atomic<uint32_t> lastStepTick;
+    std::atomic<uint32_t> threadPriority;
+    std::atomic<int> threadCoreId;
+    int requestedCoreId;  ///< Set by SetCoreAffinity() before creation; kNoCoreRequest otherwise.
+    static constexpr int kNoCoreRequest = -2;
+    CpuUsageWindow cpuUsage;
+    std::atomic<uint32_t> deadlineMisses;
+    std::atomic<uint32_t> consecutiveDeadlineMisses;
+    std::atomic<uint32_t> maxConsecutiveDeadlineMisses;
+    std::atomic<uint32_t> worstDeadlineOverrunUs;
+
+#if defined(HF_BASETHREAD_STEP_STATS)
+    LatencyHistogram stepTimeHistogram;
+    LatencyHistogram startJitterHistogram;
+    uint64_t expectedStepStartUs{0};    ///< When the next Step() should begin; 0 before the first Step() of a run.
+#endif
+
 };
 
 #endif /* BaseThread */
@@ -5,9 +5,16 @@
  *
  * Useful when several worker threads share a lifecycle (e.g. all
  * middleware sub-threads brought up at boot and torn down on shutdown).
+ * Declare start-order constraints with `SetDependencies()`; the
+ * `*AndWaitToVerify` calls then bring threads up one dependency level at a
+ * time (each level in parallel) and shut them down in reverse.
+ * `PublishHealth()` samples every thread into an `hf::SeqlockSnapshot`
+ * table that telemetry reads lock-free with `ReadHealth()`;
+ * `SampleCpuUsage()` adds per-thread CPU share and per-core idle to it.
  *
  * Thread-safety: the registry is guarded by an internal mutex; callers may
- * register / start / stop from any task context.
+ * register / start / stop from any task context. The health table is read
+ * without that mutex.
  *
  * Allocation: the registry uses `std::map`, so each registration allocates
  * once. The threads themselves never allocate stack — the caller supplies
@@ -20,7 +27,10 @@
 #define HF_UTILS_RTOS_WRAP_BASETHREADSMANAGER_H_
 
 #include <map>
+#include <array>
+#include <atomic>
 #include <bitset>
+#include <algorithm>
 #include <functional>
 
 #include "OsAbstraction.h"
@@ -30,6 +40,7 @@
 #include "BaseThread.h"
 #include "Mutex.h"
 #include "MutexGuard.h"
+#include "SeqlockSnapshot.h"
 
 //==============================================================//
 // CLASS
@@ -37,6 +48,39 @@
 template <typename EnumType, EnumType MaxCount> class BaseThreadsManager
 {
 	public:
+		/**
+		 * @brief Lifecycle state of one thread in the health table.
+		 */
+		enum class ThreadState : uint8_t {
+			NotManaged,		/**< No thread registered for this id. */
+			NotCreated,		/**< Registered, OS task not created yet. */
+			Stopped,		/**< Waiting for Start(). */
+			Stepping,		/**< Running, inside Step() / Setup(). */
+			Waiting			/**< Running, in the delay / wait between steps. */
+		};
+
+		/**
+		 * @brief Status of one thread at the last PublishHealth().
+		 */
+		struct ThreadHealth {
+			ThreadState state;
+			int8_t coreId;					/**< -1 for no affinity. */
+			uint32_t priority;
+			uint32_t stepCount;
+			uint32_t lastStepTick;			/**< os_time_get() at the start of the latest Step(). */
+			uint32_t stackHighWaterMark;	/**< Minimum remaining stack, as reported by the RTOS. */
+			CpuUsageWindow::Usage cpu;		/**< As of the latest SampleCpuUsage(). */
+		};
+
+		/**
+		 * @brief Status of every id, sampled together by PublishHealth().
+		 */
+		struct HealthTable {
+			uint32_t sampleTick;			/**< os_time_get() when the table was sampled. */
+			std::array<ThreadHealth, static_cast<size_t>(MaxCount)> threads;	/**< Indexed by id. */
+			std::array<CpuUsageWindow::Usage, HF_RTOS_MAX_CORES> coreIdle;		/**< Idle share per core; zero where not measured. */
+		};
+
 		BaseThreadsManager(const std::map<EnumType, BaseThread*>& threads, std::function<const char*(EnumType)> enumToStringFunc) ;
 
 		/**
@@ -86,6 +130,117 @@ template <typename EnumType, EnumType MaxCount> class BaseThreadsManager
 
 		bool StopAllExceptSelectedAndWaitToVerify(const std::vector<EnumType>& selectedEnums, uint32_t waitToVerifyTimeoutMsec) noexcept;
 
+		/**
+		 * @brief Declare that every thread in @p dependsOn must be running with its Setup()
+		 *        complete before @p threadId is started, and stop only after it, in the
+		 *        *AndWaitToVerify calls.
+		 *
+		 * Threads with no dependency left are started together, then the manager waits
+		 * for them to report running before starting the next level, so boot time is the
+		 * critical path rather than the sum of all waits. Stopping walks the levels in
+		 * reverse. Replaces any dependencies declared earlier for @p threadId. The plain
+		 * Start / Stop calls do not wait and ignore the ordering.
+		 *
+		 * @return False if an id is not managed or the edges would form a cycle (the
+		 *         previous edges are kept).
+		 */
+		bool SetDependencies(EnumType threadId, const std::vector<EnumType>& dependsOn) noexcept;
+
+		/**
+		 * @brief Copy the deadline counters of one managed thread.
+		 * @return False if @p threadId is not managed.
+		 */
+		bool GetDeadlineStats(EnumType threadId, BaseThread::DeadlineStats& stats) const noexcept;
+
+		/**
+		 * @brief Sum of the deadline misses of every managed thread.
+		 */
+		uint32_t GetTotalDeadlineMisses() const noexcept;
+
+		/**
+		 * @brief Sample every managed thread and publish the table to readers.
+		 *
+		 * Takes no manager mutex and never blocks the sampled threads. Call it from
+		 * one task at the rate telemetry needs (e.g. a low-priority monitor); the cost
+		 * is dominated by the RTOS stack high-water scan of each thread.
+		 *
+		 * @return False if another PublishHealth() call is in progress.
+		 */
+		bool PublishHealth() noexcept;
+
+		/**
+		 * @brief Copy the last published health table; lock-free and wait-free without a
+		 *        concurrent PublishHealth().
+		 * @return Snapshot sequence; 0 if nothing was published yet.
+		 */
+		uint32_t ReadHealth(HealthTable& table) const noexcept { return health.Read(table); }
+
+		/**
+		 * @brief Read side of the health table, for WaitForChange() / SetWakeTarget() users.
+		 */
+		hf::SnapshotReader<HealthTable>& GetHealthReader() noexcept { return health; }
+
+		/**
+		 * @brief Sample the CPU-time counter of every managed thread and the idle time of
+		 *        every core. Call at a fixed period from one task — once per second gives
+		 *        1 s / 10 s windows. O(1) per thread and core; takes no manager mutex.
+		 * @return False if another SampleCpuUsage() call is in progress.
+		 */
+		bool SampleCpuUsage() noexcept;
+
+		/**
+		 * @brief CPU share of one thread in permille of a core.
+		 * @return False if @p threadId is not managed.
+		 */
+		bool GetCpuUsage(EnumType threadId, CpuUsageWindow::Usage& usage) const noexcept;
+
+		/**
+		 * @brief Idle share of one core in permille.
+		 * @return False if the core's idle time is not measured (host backend, or a
+		 *         kernel without run-time stats).
+		 */
+		bool GetCoreIdle(int core, CpuUsageWindow::Usage& usage) const noexcept;
+
+		/**
+		 * @brief Let the manager choose each thread's core.
+		 *
+		 * Enable before EnsureInitialized() to spread threads across cores at creation
+		 * (overriding the `core_id` each thread passes to CreateBaseThread()); then call
+		 * RebalanceCores() periodically to move threads by measured load.
+		 */
+		void SetAutoPlacement(bool enable) noexcept { autoPlacement = enable; }
+
+		/**
+		 * @brief Keep @p threadIds on the same core (e.g. threads sharing a cache-hot
+		 *        buffer or a peripheral); merges with groups declared earlier.
+		 * @return False if an id is not managed or the group is pinned to two cores.
+		 */
+		bool SetColocated(const std::vector<EnumType>& threadIds) noexcept;
+
+		/**
+		 * @brief Exclude @p threadId (and its co-located group) from balancing and keep it
+		 *        on @p core.
+		 * @return False if an id is not managed, the core is invalid or the group is
+		 *         already pinned elsewhere.
+		 */
+		bool PinToCore(EnumType threadId, int core) noexcept;
+
+		/**
+		 * @brief Re-pin threads so the long-window CPU load (see SampleCpuUsage()) is
+		 *        balanced across cores, honouring pins and co-location.
+		 *
+		 * Groups are placed heaviest first on the least-loaded core. Threads move only
+		 * if that lowers the busiest core by more than kRebalanceHysteresisPermille, so
+		 * placement does not oscillate, or if the current placement breaks a constraint.
+		 * Re-pinning needs backend support (see os_thread_affinity_set()); where it is
+		 * missing only placement at creation applies.
+		 *
+		 * @return True if at least one thread was moved.
+		 */
+		bool RebalanceCores() noexcept;
+
+		static constexpr uint32_t kRebalanceHysteresisPermille = 100;
+
 		virtual bool PreThreadInitializationActions() noexcept;
 
 		virtual bool PostThreadInitializationActions() noexcept;
@@ -98,11 +253,69 @@ template <typename EnumType, EnumType MaxCount> class BaseThreadsManager
 		 */
 		bool Initialize() noexcept;
 
+		/**
+		 * @brief Managed threads accepted by @p isTarget.
+		 */
+		template <typename Predicate>
+		std::bitset<MaxCount> SelectThreads(Predicate isTarget) const noexcept;
+
+		/**
+		 * @brief Threads of @p targets not yet started whose dependencies in @p targets are all started.
+		 */
+		std::bitset<MaxCount> NextStartLevel(const std::bitset<MaxCount>& targets, const std::bitset<MaxCount>& started) const noexcept;
+
+		/**
+		 * @brief Threads of @p targets not yet stopped that no running thread in @p targets depends on.
+		 */
+		std::bitset<MaxCount> NextStopLevel(const std::bitset<MaxCount>& targets, const std::bitset<MaxCount>& stopped) const noexcept;
+
+		static constexpr size_t kThreadCount = static_cast<size_t>(MaxCount);
+
+		/**
+		 * @brief Number of cores placement may use.
+		 */
+		static int PlacementCoreCount() noexcept;
+
+		/**
+		 * @brief Assign every co-location group a core: pinned groups first, then the rest
+		 *        heaviest first onto the core with the least load (fewest threads on a tie).
+		 * @param groupLoad  Load of each group, indexed by its representative id.
+		 * @param groupCore  Out: chosen core per group.
+		 * @param coreLoad   Out: resulting load per core.
+		 */
+		void PlaceGroups(const uint32_t (&groupLoad)[kThreadCount], int (&groupCore)[kThreadCount], uint32_t (&coreLoad)[HF_RTOS_MAX_CORES]) const noexcept;
+
+		/**
+		 * @brief True if any managed thread declared a dependency on @p threadId.
+		 */
+		bool IsDependedOn(EnumType threadId) const noexcept;
+
+		/**
+		 * @brief Start @p targets level by level, waiting for each level to report running
+		 *        (ready, for threads others depend on) before starting the next. All levels share one deadline.
+		 * @return False on a timeout (later levels are left stopped) or a dependency cycle.
+		 */
+		bool StartInDependencyOrder(const std::bitset<MaxCount>& targets, uint32_t waitToVerifyTimeoutMsec) noexcept;
+
+		/**
+		 * @brief Stop @p targets in reverse dependency order, waiting for each level to report
+		 *        stopped before stopping the threads it depends on. All levels share one deadline.
+		 * @return True if every targeted thread stopped in time.
+		 */
+		bool StopInDependencyOrder(const std::bitset<MaxCount>& targets, uint32_t waitToVerifyTimeoutMsec) noexcept;
+
+		/**
+		 * @brief Block until every managed thread in @p targets reports running (or stopped)
+		 *        or @p deadlineUs passes.
+		 * @param running  True to wait for running, false to wait for stopped.
+		 * @return True if every targeted thread reached the state in time.
+		 */
+		bool WaitForThreads(bool running, uint32_t waitToVerifyTimeoutMsec, uint64_t deadlineUs, const std::bitset<MaxCount>& targets) noexcept;
+
 		//==============================================================//
 		// VERBOSE??
 		//==============================================================//
 		static constexpr bool verbose = false;
-		static constexpr bool timeBetweenChecksMsec = 10;
 
 		bool initialized; /**< Flag indicating if the MwSubThreadsManager is initialized. */
 
@@ -115,6 +328,19 @@ template <typename EnumType, EnumType MaxCount> class BaseThreadsManager
 		std::bitset<MaxCount> threadsInitializedTracker;
 		std::bitset<MaxCount> threadsStartedTracker;
 		std::bitset<MaxCount> threadsStoppedTracker;
+
+		std::bitset<MaxCount> dependencies[MaxCount]; /**< dependencies[i]: threads that must run before i. */
+
+		hf::SeqlockSnapshot<HealthTable> health;
+		std::atomic<bool> healthPublishing; /**< Keeps PublishHealth() the seqlock's single writer. */
+
+		CpuUsageWindow coreIdle[HF_RTOS_MAX_CORES];
+		std::atomic<uint32_t> coreIdleMeasured;	/**< Bit per core whose idle time could be read. */
+		std::atomic<bool> cpuSampling;			/**< Keeps SampleCpuUsage() the windows' single sampler. */
+
+		bool autoPlacement;
+		size_t placementGroup[kThreadCount];	/**< Co-location group of each id, named by its lowest member. */
+		int pinnedCore[kThreadCount];			/**< Core a group is pinned to, indexed by group; -1 if free. */
 };
 
 
@@ -126,9 +352,19 @@ BaseThreadsManager<EnumType, MaxCount>::BaseThreadsManager(const std::map<EnumTy
 	enumToString(enumToStringFunc),
 	threadsInitializedTracker(),
 	threadsStartedTracker(),
-	threadsStoppedTracker()
+	threadsStoppedTracker(),
+	dependencies(),
+	health(),
+	healthPublishing(false),
+	coreIdle(),
+	coreIdleMeasured(0),
+	cpuSampling(false),
+	autoPlacement(false)
 {
-	/// No code at this time.
+	for(size_t i = 0; i < kThreadCount; ++i) {
+		placementGroup[i] = i;
+		pinnedCore[i] = -1;
+	}
 }
 
 template <typename EnumType, EnumType MaxCount>
@@ -271,38 +507,8 @@ bool BaseThreadsManager<EnumType, MaxCount>::StartAllAndWaitToVerify(uint32_t wa
 	{
 		MutexGuard guard(mutex);
 
-
-		for(auto& threadMap : threadsManaged) {
-			threadMap.second->Start();
-		}
-
-
-		/// Function that will test if the thread has been started
-		std::function<bool()> CheckIfAllHalSubThreadsAreStarted = [this]() {
-			for(auto& threadMap : threadsManaged) {
-				threadsStartedTracker[threadMap.first] = threadMap.second->IsThreadRunning();
-			}
-			return threadsStartedTracker.all();
-		};
-
-		const uint32_t waitStartTimeMsec = os_get_elapsed_time_msec();
-
-		/// Expecting true within the timeout specified
-		bool result = TestLogicWithTimeout(CheckIfAllHalSubThreadsAreStarted, true, waitToVerifyTimeoutMsec, timeBetweenChecksMsec);
-
-		const uint32_t elapsedStartTimeMsec = os_get_elapsed_time_msec() - waitStartTimeMsec;
-
-		/// Print info to user.
-
-		if (result) {
-		}
-		else {
-		}
-
-		for(auto& threadMap : threadsManaged) {
-		}
-
-		return result; /// Return result
+		/// Start dependencies first, one level at a time; all levels share one deadline
+		return StartInDependencyOrder(SelectThreads([](EnumType) { return true; }), waitToVerifyTimeoutMsec);
 	}
 
 	return false;
@@ -315,50 +521,10 @@ bool BaseThreadsManager<EnumType, MaxCount>::StartSelectedAndWaitToVerify(const
 	{
 		MutexGuard guard(mutex);
 
-
-
-		for(const auto& enumValue : selectedEnums) {
-			auto threadMap = threadsManaged.find(enumValue);
-			if(threadMap != threadsManaged.end()) {
-				threadMap->second->Start();
-			}
-		}
-
-
-
-		/// Function that will test if the specified threads has been started
-		std::function<bool()> CheckIfAllSelectedThreadsAreStarted = [this, selectedEnums] {
-			/// Get if the selected threads are running
-			for(const auto& enumValue : selectedEnums) {
-				threadsStartedTracker[enumValue] = threadsManaged[enumValue]->IsThreadRunning();
-			}
-			/// Check if all specified subthreads have started
-			for(const auto& enumValue : selectedEnums) {
-				if(!threadsStartedTracker[enumValue]) {
-					return false;
-				}
-			}
-			return true;
-		};
-
-		const uint32_t waitStartTimeMsec = os_get_elapsed_time_msec();
-
-		/// Expecting true within the timeout specified
-		bool result = TestLogicWithTimeout(CheckIfAllSelectedThreadsAreStarted, true, waitToVerifyTimeoutMsec, timeBetweenChecksMsec);
-
-		const uint32_t elapsedStartTimeMsec = os_get_elapsed_time_msec() - waitStartTimeMsec;
-
-		/// Print info to user.
-
-		if (result) {
-		}
-		else {
-		}
-
-		for(const auto& enumValue : selectedEnums) {
-		}
-
-		return result; /// Return result
+		/// Start dependencies first, one level at a time; all levels share one deadline
+		return StartInDependencyOrder(SelectThreads([&selectedEnums](EnumType e) {
+			return std::find(selectedEnums.begin(), selectedEnums.end(), e) != selectedEnums.end();
+		}), waitToVerifyTimeoutMsec);
 	}
 
 	return false;
@@ -371,57 +537,10 @@ bool BaseThreadsManager<EnumType, MaxCount>::StartAllExceptSelectedAndWaitToVeri
 	{
 		MutexGuard guard(mutex);
 
-
-
-		/// For all threads managed
-		for(const auto& threadMap : threadsManaged) {
-			/// If they're not in the selected threads list indicated not to start
-			if(std::find(selectedEnums.begin(), selectedEnums.end(), threadMap.first) == selectedEnums.end()) {
-				/// Start threads
-				threadMap.second->Start();
-			}
-		}
-
-
-		/// Function that will test if the specified threads has been started
-		std::function<bool()> CheckIfAllExceptSelectedThreadsAreStarted = [this, selectedEnums] {
-			/// Get if the threads not selected are running
-			for(const auto& threadMap : threadsManaged) {
-				if(std::find(selectedEnums.begin(), selectedEnums.end(), threadMap.first) == selectedEnums.end()) {
-					threadsStartedTracker[threadMap.first] = threadMap.second->IsThreadRunning();
-				}
-			}
-			/// Check if all threads not selected have started
-			for(const auto& threadMap : threadsManaged) {
-				if(std::find(selectedEnums.begin(), selectedEnums.end(), threadMap.first) == selectedEnums.end()) {
-					if(!threadsStartedTracker[threadMap.first]) {
-						return false;
-					}
-				}
-			}
-			return true;
-		};
-
-		const uint32_t waitStartTimeMsec = os_get_elapsed_time_msec();
-
-		/// Expecting true within the timeout specified
-		bool result = TestLogicWithTimeout(CheckIfAllExceptSelectedThreadsAreStarted, true, waitToVerifyTimeoutMsec, timeBetweenChecksMsec);
-
-		const uint32_t elapsedStartTimeMsec = os_get_elapsed_time_msec() - waitStartTimeMsec;
-
-		/// Print info to user.
-
-		if (result) {
-		}
-		else {
-		}
-
-		for(const auto& threadMap : threadsManaged) {
-			if(std::find(selectedEnums.begin(), selectedEnums.end(), threadMap.first) == selectedEnums.end()) {
-			}
-		}
-
-		return result; /// Return result
+		/// Start dependencies first, one level at a time; all levels share one deadline
+		return StartInDependencyOrder(SelectThreads([&selectedEnums](EnumType e) {
+			return std::find(selectedEnums.begin(), selectedEnums.end(), e) == selectedEnums.end();
+		}), waitToVerifyTimeoutMsec);
 	}
 
 	return false;
@@ -504,130 +623,509 @@ bool BaseThreadsManager<EnumType, MaxCount>::StopAllAndWaitToVerify(uint32_t wai
 	{
 		MutexGuard guard(mutex);
 
+		/// Stop dependents first, one level at a time; all levels share one deadline
+		return StopInDependencyOrder(SelectThreads([](EnumType) { return true; }), waitToVerifyTimeoutMsec);
+	}
 
-		for(auto& threadMap : threadsManaged) {
-			threadsStoppedTracker[threadMap.first] = threadMap.second->Stop();
-		}
-
+	return false;
+}
 
-		/// Function that will test if the thread has been started
-		std::function<bool()> CheckIfAllHalSubThreadsAreStopped = [this]() {
-			for(auto& threadMap : threadsManaged) {
-				threadsStoppedTracker[threadMap.first] = threadMap.second->IsThreadStopped();
-			}
-			return threadsStoppedTracker.all();
-		};
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::StopSelectedAndWaitToVerify(const std::vector<EnumType>& selectedEnums, uint32_t waitToVerifyTimeoutMsec) noexcept
+{
+	if (EnsureInitialized() )
+	{
+		MutexGuard guard(mutex);
 
-		/// Expecting true within the timeout specified
-		const bool result = TestLogicWithTimeout(
-		    CheckIfAllHalSubThreadsAreStopped, true, waitToVerifyTimeoutMsec, timeBetweenChecksMsec);
-		return result;
+		/// Stop dependents first, one level at a time; all levels share one deadline
+		return StopInDependencyOrder(SelectThreads([&selectedEnums](EnumType e) {
+			return std::find(selectedEnums.begin(), selectedEnums.end(), e) != selectedEnums.end();
+		}), waitToVerifyTimeoutMsec);
 	}
 
 	return false;
 }
 
 template <typename EnumType, EnumType MaxCount>
-bool BaseThreadsManager<EnumType, MaxCount>::StopSelectedAndWaitToVerify(const std::vector<EnumType>& selectedEnums, uint32_t waitToVerifyTimeoutMsec) noexcept
+bool BaseThreadsManager<EnumType, MaxCount>::StopAllExceptSelectedAndWaitToVerify(const std::vector<EnumType>& selectedEnums, uint32_t waitToVerifyTimeoutMsec) noexcept
 {
 	if (EnsureInitialized() )
 	{
 		MutexGuard guard(mutex);
-;
 
+		/// Stop dependents first, one level at a time; all levels share one deadline
+		return StopInDependencyOrder(SelectThreads([&selectedEnums](EnumType e) {
+			return std::find(selectedEnums.begin(), selectedEnums.end(), e) == selectedEnums.end();
+		}), waitToVerifyTimeoutMsec);
+	}
 
-		for(const auto& enumValue : selectedEnums) {
-			auto threadMap = threadsManaged.find(enumValue);
-			if(threadMap != threadsManaged.end()) {
-				threadsStoppedTracker[threadMap->first] = threadMap->second->Stop();
-			}
+	return false;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::SetDependencies(EnumType threadId, const std::vector<EnumType>& dependsOn) noexcept
+{
+	MutexGuard guard(mutex);
+
+	if(threadsManaged.find(threadId) == threadsManaged.end()) {
+		return false;
+	}
+
+	std::bitset<MaxCount> required;
+	for(const auto& dependency : dependsOn) {
+		if(dependency == threadId || threadsManaged.find(dependency) == threadsManaged.end()) {
+			return false;
+		}
+		required[dependency] = true;
+	}
+
+	/// Keep the previous edges if the new ones would close a cycle
+	const std::bitset<MaxCount> previous = dependencies[threadId];
+	dependencies[threadId] = required;
+
+	std::bitset<MaxCount> everyThread = SelectThreads([](EnumType) { return true; });
+	std::bitset<MaxCount> started;
+	while(started != everyThread) {
+		const std::bitset<MaxCount> level = NextStartLevel(everyThread, started);
+		if(level.none()) {
+			dependencies[threadId] = previous;
+			return false;
+		}
+		started |= level;
+	}
+	return true;
+}
+
+template <typename EnumType, EnumType MaxCount>
+template <typename Predicate>
+std::bitset<MaxCount> BaseThreadsManager<EnumType, MaxCount>::SelectThreads(Predicate isTarget) const noexcept
+{
+	std::bitset<MaxCount> targets;
+	for(const auto& threadMap : threadsManaged) {
+		if(isTarget(threadMap.first)) {
+			targets[threadMap.first] = true;
+		}
+	}
+	return targets;
+}
+
+template <typename EnumType, EnumType MaxCount>
+std::bitset<MaxCount> BaseThreadsManager<EnumType, MaxCount>::NextStartLevel(const std::bitset<MaxCount>& targets, const std::bitset<MaxCount>& started) const noexcept
+{
+	/// Ready once every dependency inside the target set has been started; edges to threads
+	/// outside the set are the caller's responsibility.
+	std::bitset<MaxCount> level;
+	for(size_t i = 0; i < static_cast<size_t>(MaxCount); ++i) {
+		if(targets[i] && !started[i] && (dependencies[i] & targets & ~started).none()) {
+			level[i] = true;
+		}
+	}
+	return level;
+}
+
+template <typename EnumType, EnumType MaxCount>
+std::bitset<MaxCount> BaseThreadsManager<EnumType, MaxCount>::NextStopLevel(const std::bitset<MaxCount>& targets, const std::bitset<MaxCount>& stopped) const noexcept
+{
+	/// Ready once nothing still running in the target set depends on it.
+	const std::bitset<MaxCount> running = targets & ~stopped;
+	std::bitset<MaxCount> neededByRunning;
+	for(size_t i = 0; i < static_cast<size_t>(MaxCount); ++i) {
+		if(running[i]) {
+			neededByRunning |= dependencies[i];
 		}
+	}
+	return running & ~neededByRunning;
+}
 
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::IsDependedOn(EnumType threadId) const noexcept
+{
+	for(size_t i = 0; i < static_cast<size_t>(MaxCount); ++i) {
+		if(dependencies[i][threadId]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::StartInDependencyOrder(const std::bitset<MaxCount>& targets, uint32_t waitToVerifyTimeoutMsec) noexcept
+{
+	const uint64_t deadlineUs = os_time_get_us() + static_cast<uint64_t>(waitToVerifyTimeoutMsec) * 1000ULL;
+
+	std::bitset<MaxCount> started;
+	while(started != targets) {
+		const std::bitset<MaxCount> level = NextStartLevel(targets, started);
+		if(level.none()) {
+			return false;
+		}
 
-		/// Function that will test if the specified threads has been stopped
-		std::function<bool()> CheckIfAllSelectedThreadsAreStopped = [this, selectedEnums] {
-			for(const auto& enumValue : selectedEnums) {
-				threadsStoppedTracker[enumValue] = threadsManaged[enumValue]->IsThreadStopped();
+		for(auto& threadMap : threadsManaged) {
+			if(level[threadMap.first]) {
+				threadMap.second->Start();
 			}
-			for(const auto& enumValue : selectedEnums) {
-				if(!threadsStoppedTracker[enumValue]) {
-					return false;
-				}
+		}
+
+		/// Do not start dependents of a thread that failed to come up
+		if(!WaitForThreads(true, waitToVerifyTimeoutMsec, deadlineUs, level)) {
+			return false;
+		}
+		started |= level;
+	}
+	return true;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::StopInDependencyOrder(const std::bitset<MaxCount>& targets, uint32_t waitToVerifyTimeoutMsec) noexcept
+{
+	const uint64_t deadlineUs = os_time_get_us() + static_cast<uint64_t>(waitToVerifyTimeoutMsec) * 1000ULL;
+
+	/// A thread that fails to stop still counts as handled so shutdown carries on with the rest.
+	bool result = true;
+	std::bitset<MaxCount> stopped;
+	while(stopped != targets) {
+		const std::bitset<MaxCount> level = NextStopLevel(targets, stopped);
+		if(level.none()) {
+			return false;
+		}
+
+		for(auto& threadMap : threadsManaged) {
+			if(level[threadMap.first]) {
+				threadsStoppedTracker[threadMap.first] = threadMap.second->Stop();
 			}
-			return true;
-		};
+		}
 
-		/// Expecting true within the timeout specified
-		const bool result = TestLogicWithTimeout(
-		    CheckIfAllSelectedThreadsAreStopped, true, waitToVerifyTimeoutMsec, timeBetweenChecksMsec);
-		return result;
+		result = WaitForThreads(false, waitToVerifyTimeoutMsec, deadlineUs, level) && result;
+		stopped |= level;
 	}
+	return result;
+}
 
-	return false;
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::WaitForThreads(bool running, uint32_t waitToVerifyTimeoutMsec, uint64_t deadlineUs, const std::bitset<MaxCount>& targets) noexcept
+{
+	bool result = true;
+	for(auto& threadMap : threadsManaged) {
+		if(!targets[threadMap.first]) {
+			continue;
+		}
+
+		uint32_t remainingMsec = UINT32_MAX;
+		if(waitToVerifyTimeoutMsec != UINT32_MAX) {
+			const uint64_t nowUs = os_time_get_us();
+			remainingMsec = (nowUs < deadlineUs) ? static_cast<uint32_t>((deadlineUs - nowUs + 999U) / 1000U) : 0U;
+		}
+
+		/// A thread others depend on must also have finished Setup() before its dependents start
+		bool reached = false;
+		if(!running) {
+			reached = threadMap.second->WaitUntilStopped(remainingMsec);
+		} else if(IsDependedOn(threadMap.first)) {
+			reached = threadMap.second->WaitUntilReady(remainingMsec);
+		} else {
+			reached = threadMap.second->WaitUntilRunning(remainingMsec);
+		}
+		if(running) {
+			threadsStartedTracker[threadMap.first] = reached;
+		} else {
+			threadsStoppedTracker[threadMap.first] = reached;
+		}
+		result = result && reached;
+	}
+	return result;
 }
 
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::GetDeadlineStats(EnumType threadId, BaseThread::DeadlineStats& stats) const noexcept
+{
+	/// The registry is fixed at construction and the counters are atomics, so no lock is needed.
+	const auto threadMap = threadsManaged.find(threadId);
+	if(threadMap == threadsManaged.end()) {
+		return false;
+	}
+	stats = threadMap->second->GetDeadlineStats();
+	return true;
+}
 
 template <typename EnumType, EnumType MaxCount>
-bool BaseThreadsManager<EnumType, MaxCount>::StopAllExceptSelectedAndWaitToVerify(const std::vector<EnumType>& selectedEnums, uint32_t waitToVerifyTimeoutMsec) noexcept
+uint32_t BaseThreadsManager<EnumType, MaxCount>::GetTotalDeadlineMisses() const noexcept
 {
-	if (EnsureInitialized() )
-	{
-		MutexGuard guard(mutex);
+	uint32_t misses = 0;
+	for(const auto& threadMap : threadsManaged) {
+		misses += threadMap.second->GetDeadlineStats().misses;
+	}
+	return misses;
+}
 
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::PublishHealth() noexcept
+{
+	if(healthPublishing.exchange(true, std::memory_order_acquire)) {
+		return false;
+	}
 
-		/// For all threads managed
-		for(const auto& threadMap : threadsManaged) {
-			/// If they're not in the selected threads list indicated not to start
-			if(std::find(selectedEnums.begin(), selectedEnums.end(), threadMap.first) == selectedEnums.end()) {
-				/// Start threads
-				threadMap.second->Stop();
-			} else {
-			}
+	/// The registry is fixed at construction and every field read here is lock-free.
+	HealthTable table{};
+	table.sampleTick = static_cast<uint32_t>(os_time_get());
+	for(auto& entry : table.threads) {
+		entry.state = ThreadState::NotManaged;
+		entry.coreId = -1;
+	}
+
+	for(const auto& threadMap : threadsManaged) {
+		const BaseThread* thread = threadMap.second;
+		ThreadHealth& entry = table.threads[static_cast<size_t>(threadMap.first)];
+
+		if(!thread->IsThreadCreated()) {
+			entry.state = ThreadState::NotCreated;
+			continue;
 		}
 
+		if(thread->IsThreadStopped()) {
+			entry.state = ThreadState::Stopped;
+		} else {
+			entry.state = thread->IsThreadInStepDelay() ? ThreadState::Waiting : ThreadState::Stepping;
+		}
+		entry.coreId = static_cast<int8_t>(thread->GetCoreId());
+		entry.priority = thread->GetPriority();
+		entry.stepCount = thread->GetStepCount();
+		entry.lastStepTick = thread->GetLastStepTick();
+		entry.stackHighWaterMark = thread->GetStackHighWaterMark();
+		entry.cpu = thread->GetCpuUsage();
+	}
 
-		/// Function that will test if the specified threads has been stopped
-		std::function<bool()> CheckIfAllExceptSelectedThreadsAreStopped = [this, selectedEnums] {
-			/// Get if the threads not selected are stopped
-			for(const auto& threadMap : threadsManaged) {
-				if(std::find(selectedEnums.begin(), selectedEnums.end(), threadMap.first) == selectedEnums.end()) {
-					threadsStoppedTracker[threadMap.first] = threadMap.second->IsThreadStopped();
-				}
+	for(int core = 0; core < HF_RTOS_MAX_CORES; ++core) {
+		GetCoreIdle(core, table.coreIdle[static_cast<size_t>(core)]);
+	}
+
+	health.Publish(table);
+	healthPublishing.store(false, std::memory_order_release);
+	return true;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::SampleCpuUsage() noexcept
+{
+	if(cpuSampling.exchange(true, std::memory_order_acquire)) {
+		return false;
+	}
+
+	const uint32_t nowUs = static_cast<uint32_t>(os_time_get_us());
+	for(auto& threadMap : threadsManaged) {
+		(void)threadMap.second->SampleCpuUsage(nowUs);
+	}
+
+	const int cores = (os_get_core_count() < HF_RTOS_MAX_CORES) ? os_get_core_count() : HF_RTOS_MAX_CORES;
+	uint32_t measured = 0;
+	for(int core = 0; core < cores; ++core) {
+		uint32_t idleUs = 0;
+		if(os_core_idle_time_get(core, &idleUs) == OS_SUCCESS) {
+			coreIdle[core].Sample(idleUs, nowUs);
+			measured |= (1U << core);
+		}
+	}
+	coreIdleMeasured.store(measured, std::memory_order_relaxed);
+
+	cpuSampling.store(false, std::memory_order_release);
+	return true;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::GetCpuUsage(EnumType threadId, CpuUsageWindow::Usage& usage) const noexcept
+{
+	const auto threadMap = threadsManaged.find(threadId);
+	if(threadMap == threadsManaged.end()) {
+		return false;
+	}
+	usage = threadMap->second->GetCpuUsage();
+	return true;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::GetCoreIdle(int core, CpuUsageWindow::Usage& usage) const noexcept
+{
+	if(core < 0 || core >= HF_RTOS_MAX_CORES || (coreIdleMeasured.load(std::memory_order_relaxed) & (1U << core)) == 0U) {
+		usage = CpuUsageWindow::Usage{};
+		return false;
+	}
+	usage = coreIdle[core].Get();
+	return true;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::SetColocated(const std::vector<EnumType>& threadIds) noexcept
+{
+	MutexGuard guard(mutex);
+
+	size_t target = kThreadCount;
+	int pin = -1;
+	for(const auto& threadId : threadIds) {
+		if(threadsManaged.find(threadId) == threadsManaged.end()) {
+			return false;
+		}
+		const size_t group = placementGroup[threadId];
+		target = (group < target) ? group : target;
+		if(pinnedCore[group] >= 0) {
+			if(pin >= 0 && pin != pinnedCore[group]) {
+				return false;
 			}
-			/// Check if all threads not selected have started
-			for(const auto& threadMap : threadsManaged) {
-				if(std::find(selectedEnums.begin(), selectedEnums.end(), threadMap.first) == selectedEnums.end()) {
-					if(!threadsStoppedTracker[threadMap.first]) {
-						return false;
-					}
-				}
+			pin = pinnedCore[group];
+		}
+	}
+	if(target == kThreadCount) {
+		return true;
+	}
+
+	/// Relabel every member of the merged groups with the lowest group id
+	for(const auto& threadId : threadIds) {
+		const size_t group = placementGroup[threadId];
+		if(group == target) {
+			continue;
+		}
+		pinnedCore[group] = -1;
+		for(size_t i = 0; i < kThreadCount; ++i) {
+			if(placementGroup[i] == group) {
+				placementGroup[i] = target;
 			}
-			return true;
-		};
+		}
+	}
+	pinnedCore[target] = pin;
+	return true;
+}
 
-		const uint32_t waitStopTimeMsec = os_get_elapsed_time_msec();
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::PinToCore(EnumType threadId, int core) noexcept
+{
+	MutexGuard guard(mutex);
 
-		/// Expecting true within the timeout specified
-		bool result = TestLogicWithTimeout(CheckIfAllExceptSelectedThreadsAreStopped, true, waitToVerifyTimeoutMsec, timeBetweenChecksMsec);
+	if(threadsManaged.find(threadId) == threadsManaged.end() || core < 0 || core >= PlacementCoreCount()) {
+		return false;
+	}
+	const size_t group = placementGroup[threadId];
+	if(pinnedCore[group] >= 0 && pinnedCore[group] != core) {
+		return false;
+	}
+	pinnedCore[group] = core;
+	return true;
+}
 
-		const uint32_t elapsedStopTimeMsec = os_get_elapsed_time_msec() - waitStopTimeMsec;
+template <typename EnumType, EnumType MaxCount>
+bool BaseThreadsManager<EnumType, MaxCount>::RebalanceCores() noexcept
+{
+	const int cores = PlacementCoreCount();
+	if(!autoPlacement || cores < 2 || !EnsureInitialized()) {
+		return false;
+	}
 
-		/// Print info to user.
+	MutexGuard guard(mutex);
 
-		if (result) {
+	/// Current per-core load; a thread without affinity, off its pinned core or apart
+	/// from its group is misplaced and forces a move regardless of load
+	uint32_t groupLoad[kThreadCount] = {};
+	uint32_t currentLoad[HF_RTOS_MAX_CORES] = {};
+	int groupSeenCore[kThreadCount];
+	for(size_t group = 0; group < kThreadCount; ++group) {
+		groupSeenCore[group] = pinnedCore[group];
+	}
+	bool misplaced = false;
+	for(const auto& threadMap : threadsManaged) {
+		const size_t group = placementGroup[threadMap.first];
+		const uint32_t load = threadMap.second->GetCpuUsage().longPermille;
+		groupLoad[group] += load;
+		const int core = threadMap.second->GetCoreId();
+		if(core >= 0 && core < cores) {
+			currentLoad[core] += load;
 		}
-		else {
+		if(core < 0 || core >= cores || (groupSeenCore[group] >= 0 && groupSeenCore[group] != core)) {
+			misplaced = true;
 		}
+		groupSeenCore[group] = core;
+	}
 
-		for(const auto& threadMap : threadsManaged) {
-			if(std::find(selectedEnums.begin(), selectedEnums.end(), threadMap.first) == selectedEnums.end()) {
-			}
+	int groupCore[kThreadCount];
+	uint32_t proposedLoad[HF_RTOS_MAX_CORES];
+	PlaceGroups(groupLoad, groupCore, proposedLoad);
+
+	uint32_t currentMax = 0;
+	uint32_t proposedMax = 0;
+	for(int core = 0; core < cores; ++core) {
+		currentMax = (currentLoad[core] > currentMax) ? currentLoad[core] : currentMax;
+		proposedMax = (proposedLoad[core] > proposedMax) ? proposedLoad[core] : proposedMax;
+	}
+	if(!misplaced && proposedMax + kRebalanceHysteresisPermille >= currentMax) {
+		return false;
+	}
+
+	bool moved = false;
+	for(auto& threadMap : threadsManaged) {
+		const int core = groupCore[placementGroup[threadMap.first]];
+		if(threadMap.second->GetCoreId() != core && threadMap.second->SetCoreAffinity(core)) {
+			moved = true;
 		}
+	}
+	return moved;
+}
 
-		return result; /// Return result
+template <typename EnumType, EnumType MaxCount>
+int BaseThreadsManager<EnumType, MaxCount>::PlacementCoreCount() noexcept
+{
+	const int cores = os_get_core_count();
+	return (cores < HF_RTOS_MAX_CORES) ? cores : HF_RTOS_MAX_CORES;
+}
+
+template <typename EnumType, EnumType MaxCount>
+void BaseThreadsManager<EnumType, MaxCount>::PlaceGroups(const uint32_t (&groupLoad)[kThreadCount], int (&groupCore)[kThreadCount], uint32_t (&coreLoad)[HF_RTOS_MAX_CORES]) const noexcept
+{
+	const int cores = PlacementCoreCount();
+	uint32_t coreThreads[HF_RTOS_MAX_CORES] = {};
+	uint32_t groupSize[kThreadCount] = {};
+	for(const auto& threadMap : threadsManaged) {
+		++groupSize[placementGroup[threadMap.first]];
+	}
+	for(int core = 0; core < HF_RTOS_MAX_CORES; ++core) {
+		coreLoad[core] = 0;
 	}
 
-	return false;
+	/// Pinned groups first; collect the free ones
+	size_t order[kThreadCount];
+	size_t freeGroups = 0;
+	for(size_t group = 0; group < kThreadCount; ++group) {
+		groupCore[group] = -1;
+		if(groupSize[group] == 0U) {
+			continue;
+		}
+		if(pinnedCore[group] >= 0) {
+			groupCore[group] = pinnedCore[group];
+			coreLoad[pinnedCore[group]] += groupLoad[group];
+			coreThreads[pinnedCore[group]] += groupSize[group];
+		} else {
+			order[freeGroups++] = group;
+		}
+	}
+
+	/// Heaviest first (insertion sort; the group count is small)
+	for(size_t i = 1; i < freeGroups; ++i) {
+		const size_t group = order[i];
+		size_t j = i;
+		while(j > 0 && groupLoad[order[j - 1]] < groupLoad[group]) {
+			order[j] = order[j - 1];
+			--j;
+		}
+		order[j] = group;
+	}
+
+	for(size_t i = 0; i < freeGroups; ++i) {
+		const size_t group = order[i];
+		int best = 0;
+		for(int core = 1; core < cores; ++core) {
+			if(coreLoad[core] < coreLoad[best] || (coreLoad[core] == coreLoad[best] && coreThreads[core] < coreThreads[best])) {
+				best = core;
+			}
+		}
+		groupCore[group] = best;
+		coreLoad[best] += groupLoad[group];
+		coreThreads[best] += groupSize[group];
+	}
 }
 
 template <typename EnumType, EnumType MaxCount>
@@ -656,6 +1154,19 @@ bool BaseThreadsManager<EnumType, MaxCount>::Initialize() noexcept
 		/// If pre thread initialization actions fail, return false
 		if( !PreThreadInitializationActions() ) { return false; }
 
+		/// Nothing has been measured yet, so this spreads the groups by thread count
+		if(autoPlacement && PlacementCoreCount() > 1) {
+			const uint32_t groupLoad[kThreadCount] = {};
+			int groupCore[kThreadCount];
+			uint32_t coreLoad[HF_RTOS_MAX_CORES];
+			PlaceGroups(groupLoad, groupCore, coreLoad);
+			for(auto& threadMap : threadsManaged) {
+				if(!threadMap.second->IsThreadCreated()) {
+					(void)threadMap.second->SetCoreAffinity(groupCore[placementGroup[threadMap.first]]);
+				}
+			}
+		}
+
 		for(auto& threadMap : threadsManaged) {
 			bool threadInitialized = threadMap.second->EnsureInitialized();
 			threadsInitializedTracker[threadMap.first] = threadInitialized;
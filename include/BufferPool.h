@@ -0,0 +1,465 @@
+/**
+ * @file BufferPool.h
+ * @brief Fixed-size block pool and handle queue for zero-copy hand-off of
+ *        large payloads.
+ *
+ * A producer acquires a block from `BufferPool<BlockSize, Count>`, fills it
+ * in place and sends the `Handle` through a `BufferQueue`; the consumer reads
+ * it in place and the block returns to the pool when the handle goes out of
+ * scope. Only a 2-byte block reference travels through the queue, so payload
+ * bytes are never copied.
+ *
+ * The free list is a lock-free stack of block indices whose head carries a
+ * change counter against ABA. Unlike a ring of cells, a push onto it can
+ * never fail, so a released block is never lost. `Acquire(timeout_ms)`
+ * blocks on a counting semaphore only while the pool is exhausted.
+ *
+ * Thread-safety: any task may acquire, release, send and receive. Interrupt
+ * handlers use `TryAcquire`, `Handle::ResetFromIsr` and the `FromIsr` queue
+ * forms, and must not let a handle that still owns a block go out of scope.
+ * A block is owned by exactly one `Handle` at a time.
+ *
+ * Allocation: all blocks, lengths and free-list links are inline members
+ * (the semaphore is created eagerly in the constructor); no heap allocation
+ * under `HF_RTOS_STATIC_ALLOCATION`. The pool must
+ * outlive every handle taken from it.
+ */
+#ifndef BUFFER_POOL_H_
+#define BUFFER_POOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include "OsMpmcQueue.h"
+
+/**
+ * @brief Trivially-copyable reference to a pool block; what a `BufferQueue`
+ *        carries. Obtain with `Handle::Detach()`, turn back with
+ *        `BufferPool::Adopt()`.
+ */
+struct BufferRef {
+    static constexpr uint16_t kNone = UINT16_MAX;
+    uint16_t index{kNone};
+};
+
+/**
+ * @class BufferPool
+ * @brief `Count` blocks of `BlockSize` bytes with lock-free acquire / release.
+ *
+ * @tparam BlockSize  Usable bytes per block.
+ * @tparam Count      Number of blocks (at most 65534).
+ */
+template <size_t BlockSize, size_t Count>
+class BufferPool {
+    static_assert(BlockSize > 0U, "BufferPool blocks must not be empty");
+    static_assert(Count > 0U && Count < BufferRef::kNone, "BufferPool holds 1..65534 blocks");
+
+public:
+    /// Usage counters; `exhausted` counts acquires that found no free block.
+    struct Stats {
+        uint32_t inUse;
+        uint32_t peakInUse;
+        uint32_t acquired;
+        uint32_t exhausted;
+    };
+
+    /**
+     * @class Handle
+     * @brief Move-only owner of one block; releases it on destruction.
+     */
+    class Handle {
+    public:
+        Handle() noexcept = default;
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        Handle(Handle&& other) noexcept : pool_(other.pool_), index_(other.index_)
+        {
+            other.pool_ = nullptr;
+        }
+
+        Handle& operator=(Handle&& other) noexcept
+        {
+            if (this != &other) {
+                Reset();
+                pool_ = other.pool_;
+                index_ = other.index_;
+                other.pool_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~Handle() noexcept { Reset(); }
+
+        /// True while this handle owns a block.
+        [[nodiscard]] bool IsValid() const noexcept { return pool_ != nullptr; }
+        explicit operator bool() const noexcept { return IsValid(); }
+
+        /// Start of the block; BlockSize bytes are writable.
+        [[nodiscard]] uint8_t* Data() const noexcept { return pool_ ? pool_->BlockData(index_) : nullptr; }
+
+        /// Bytes the producer marked as valid (0 after acquire).
+        [[nodiscard]] size_t Length() const noexcept { return pool_ ? pool_->lengths_[index_] : 0U; }
+
+        /// Record how many bytes of the block hold payload (clamped to BlockSize).
+        void SetLength(size_t length) noexcept
+        {
+            if (pool_) pool_->lengths_[index_] = static_cast<uint32_t>((length < BlockSize) ? length : BlockSize);
+        }
+
+        [[nodiscard]] static constexpr size_t Capacity() noexcept { return BlockSize; }
+
+        /**
+         * @brief Give up ownership without releasing the block, e.g. to send
+         *        it through a queue. The receiver must `Adopt` it.
+         */
+        [[nodiscard]] BufferRef Detach() noexcept
+        {
+            BufferRef ref{};
+            if (pool_) {
+                ref.index = index_;
+                pool_ = nullptr;
+            }
+            return ref;
+        }
+
+        /// Return the block to the pool now.
+        void Reset() noexcept
+        {
+            if (pool_) {
+                pool_->Release(index_);
+                pool_ = nullptr;
+            }
+        }
+
+        /// Return the block to the pool from an interrupt handler.
+        void ResetFromIsr(IsrYieldScope& yield) noexcept
+        {
+            if (pool_) {
+                pool_->ReleaseFromIsr(index_, yield);
+                pool_ = nullptr;
+            }
+        }
+
+    private:
+        friend class BufferPool;
+        Handle(BufferPool* pool, uint16_t index) noexcept : pool_(pool), index_(index) {}
+
+        BufferPool* pool_{nullptr};
+        uint16_t    index_{0};
+    };
+
+    /**
+     * @brief Construct with every block free and create the blocking-acquire
+     *        semaphore eagerly.
+     */
+    explicit BufferPool(const char* poolName) noexcept
+    {
+        for (size_t i = 0; i < Count; ++i) {
+            next_[i].store(static_cast<uint16_t>((i + 1U < Count) ? i + 1U : BufferRef::kNone),
+                           std::memory_order_relaxed);
+        }
+        head_.store(0U, std::memory_order_relaxed);
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+        freedCreated_ = os_semaphore_create_static(&freed_, &freedStorage_, poolName, 0) == OS_SUCCESS;
+#else
+        freedCreated_ = os_semaphore_create(&freed_, poolName, 0) == OS_SUCCESS;
+#endif
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    ~BufferPool() noexcept
+    {
+        if (freedCreated_) {
+            (void)os_semaphore_delete(&freed_);
+        }
+    }
+
+    /// True if the blocking-acquire semaphore was created successfully.
+    [[nodiscard]] bool IsValid() const noexcept { return freedCreated_; }
+
+    /**
+     * @brief Take a free block; never blocks. Safe from an ISR.
+     * @return An invalid handle if the pool is exhausted.
+     */
+    Handle TryAcquire() noexcept
+    {
+        uint16_t index;
+        if (!Pop(index)) {
+            exhausted_.fetch_add(1U, std::memory_order_relaxed);
+            return Handle{};
+        }
+        return Acquired(index);
+    }
+
+    /**
+     * @brief Take a free block; blocks up to @p timeout_ms while the pool is
+     *        exhausted.
+     * @return An invalid handle on timeout.
+     */
+    Handle Acquire(uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        uint16_t index;
+        if (!Pop(index)) {
+            exhausted_.fetch_add(1U, std::memory_order_relaxed);
+            if (timeout_ms == 0U || !WaitForBlock(index, timeout_ms)) return Handle{};
+        }
+        return Acquired(index);
+    }
+
+    /**
+     * @brief Take ownership of a block that came out of a queue.
+     * @return An invalid handle for an empty or out-of-range reference.
+     */
+    Handle Adopt(BufferRef ref) noexcept
+    {
+        if (ref.index >= Count) return Handle{};
+        return Handle{this, ref.index};
+    }
+
+    /**
+     * @brief Snapshot of the usage counters.
+     */
+    [[nodiscard]] Stats GetStats() const noexcept
+    {
+        return Stats{ inUse_.load(std::memory_order_relaxed), peakInUse_.load(std::memory_order_relaxed),
+                      acquired_.load(std::memory_order_relaxed), exhausted_.load(std::memory_order_relaxed) };
+    }
+
+    /// Clear `peakInUse` (to the current use), `acquired` and `exhausted`.
+    void ResetStats() noexcept
+    {
+        peakInUse_.store(inUse_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        acquired_.store(0U, std::memory_order_relaxed);
+        exhausted_.store(0U, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static constexpr size_t BlockCount() noexcept { return Count; }
+    [[nodiscard]] static constexpr size_t BlockBytes() noexcept { return BlockSize; }
+
+    /**
+     * @brief Total RAM held by the pool: blocks, lengths, free list and the
+     *        semaphore control block.
+     */
+    [[nodiscard]] static constexpr size_t FootprintBytes() noexcept { return sizeof(BufferPool); }
+
+private:
+    /// Blocks are laid out at max_align_t granularity so any payload type fits.
+    static constexpr size_t kStride =
+        (BlockSize + alignof(std::max_align_t) - 1U) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    /// head_ packs the top block index (low half) with a counter bumped on
+    /// every change (high half), so a pop that read a stale next_ link fails
+    /// its compare-and-swap even if the same index is back on top.
+    static constexpr uint32_t kIndexMask = 0xFFFFU;
+    static constexpr uint32_t kTagStep   = 0x10000U;
+
+    /// Lock-free; never fails. Safe from an ISR.
+    void Push(uint16_t index) noexcept
+    {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        do {
+            next_[index].store(static_cast<uint16_t>(head & kIndexMask), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, ((head & ~kIndexMask) + kTagStep) | index,
+                                              std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /// Lock-free; false only if the stack really was empty. Safe from an ISR.
+    bool Pop(uint16_t& index) noexcept
+    {
+        uint32_t head = head_.load(std::memory_order_acquire);
+        while (true) {
+            const uint32_t top = head & kIndexMask;
+            if (top == BufferRef::kNone) return false;
+            const uint32_t next = next_[top].load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, ((head & ~kIndexMask) + kTagStep) | next,
+                                            std::memory_order_acquire, std::memory_order_acquire)) {
+                index = static_cast<uint16_t>(top);
+                return true;
+            }
+        }
+    }
+
+    /// Take one registration off waiters_; false if nobody is registered.
+    bool ClaimWaiter() noexcept
+    {
+        uint32_t count = waiters_.load(std::memory_order_relaxed);
+        while (count != 0U) {
+            if (waiters_.compare_exchange_weak(count, count - 1U, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    /// Same register / re-check / sleep protocol as OsMpmcQueue::Blocking().
+    bool WaitForBlock(uint16_t& index, uint32_t timeout_ms) noexcept
+    {
+        if (!freedCreated_) return false;
+
+        const uint64_t deadlineUs = os_time_get_us() + static_cast<uint64_t>(timeout_ms) * 1000ULL;
+        while (true) {
+            waiters_.fetch_add(1U, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (Pop(index)) {
+                (void)ClaimWaiter();
+                return true;
+            }
+
+            OS_Ulong ticks = static_cast<OS_Ulong>(OS_WAIT_FOREVER);
+            if (timeout_ms != UINT32_MAX) {
+                const uint64_t nowUs = os_time_get_us();
+                if (nowUs >= deadlineUs) {
+                    (void)ClaimWaiter();
+                    return false;
+                }
+                const uint32_t remainingMs = static_cast<uint32_t>((deadlineUs - nowUs + 999U) / 1000U);
+                ticks = static_cast<OS_Ulong>(os_convert_msec_to_delay_ticks(remainingMs));
+                if (ticks == 0U) ticks = 1U;  /// Never round a non-zero wait down to a poll.
+            }
+
+            if (os_semaphore_get(&freed_, ticks) != OS_SUCCESS) {
+                (void)ClaimWaiter();
+            }
+            if (Pop(index)) return true;
+        }
+    }
+
+    Handle Acquired(uint16_t index) noexcept
+    {
+        lengths_[index] = 0U;
+        acquired_.fetch_add(1U, std::memory_order_relaxed);
+        const uint32_t inUse = inUse_.fetch_add(1U, std::memory_order_relaxed) + 1U;
+        uint32_t peak = peakInUse_.load(std::memory_order_relaxed);
+        while (inUse > peak && !peakInUse_.compare_exchange_weak(peak, inUse, std::memory_order_relaxed)) {
+        }
+        return Handle{this, index};
+    }
+
+    void Release(uint16_t index) noexcept
+    {
+        inUse_.fetch_sub(1U, std::memory_order_relaxed);
+        Push(index);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ClaimWaiter()) {
+            (void)os_semaphore_put(&freed_);
+        }
+    }
+
+    void ReleaseFromIsr(uint16_t index, IsrYieldScope& yield) noexcept
+    {
+        inUse_.fetch_sub(1U, std::memory_order_relaxed);
+        Push(index);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ClaimWaiter()) {
+            (void)os_semaphore_put_from_isr(&freed_, yield.Flag());
+        }
+    }
+
+    uint8_t* BlockData(uint16_t index) noexcept { return &blocks_[static_cast<size_t>(index) * kStride]; }
+
+    alignas(std::max_align_t) uint8_t blocks_[kStride * Count];
+    uint32_t lengths_[Count] = {};
+    std::atomic<uint16_t> next_[Count];
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> waiters_{0};
+    bool                  freedCreated_{false};
+    OS_Semaphore          freed_{};
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_SemaphoreStorage   freedStorage_{};
+#endif
+    std::atomic<uint32_t> inUse_{0};
+    std::atomic<uint32_t> peakInUse_{0};
+    std::atomic<uint32_t> acquired_{0};
+    std::atomic<uint32_t> exhausted_{0};
+};
+
+/**
+ * @class BufferQueue
+ * @brief Queue of `BufferPool` handles; moves ownership, never payload bytes.
+ *
+ * @tparam Pool    The `BufferPool` instantiation the handles come from.
+ * @tparam kDepth  Maximum number of pending handles; a power of two.
+ */
+template <typename Pool, size_t kDepth>
+class BufferQueue {
+public:
+    using Handle = typename Pool::Handle;
+
+    BufferQueue(const char* queueName, Pool& pool) noexcept
+        : pool_(pool), queue_(queueName)
+    {
+    }
+
+    BufferQueue(const BufferQueue&) = delete;
+    BufferQueue& operator=(const BufferQueue&) = delete;
+
+    /// Handles still queued are returned to the pool.
+    ~BufferQueue() noexcept
+    {
+        BufferRef ref;
+        while (queue_.TryReceive(ref)) {
+            (void)pool_.Adopt(ref);
+        }
+    }
+
+    [[nodiscard]] bool IsValid() const noexcept { return queue_.IsValid(); }
+
+    /**
+     * @brief Send @p handle; blocks up to @p timeout_ms while the queue is full.
+     * @return true on success (@p handle is then empty); on failure the
+     *         caller keeps ownership.
+     */
+    bool Send(Handle& handle, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        if (!handle) return false;
+        BufferRef ref = handle.Detach();
+        if (queue_.Send(ref, timeout_ms)) return true;
+        handle = pool_.Adopt(ref);
+        return false;
+    }
+
+    /**
+     * @brief Receive a handle; blocks up to @p timeout_ms while the queue is empty.
+     * @return true on success; @p out then owns the block.
+     */
+    bool Receive(Handle& out, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        BufferRef ref;
+        if (!queue_.Receive(ref, timeout_ms)) return false;
+        out = pool_.Adopt(ref);
+        return true;
+    }
+
+    /// Interrupt-context forms; never block.
+    bool SendFromIsr(Handle& handle, IsrYieldScope& yield) noexcept
+    {
+        if (!handle) return false;
+        BufferRef ref = handle.Detach();
+        if (queue_.SendFromIsr(ref, yield)) return true;
+        handle = pool_.Adopt(ref);
+        return false;
+    }
+
+    bool ReceiveFromIsr(Handle& out, IsrYieldScope& yield) noexcept
+    {
+        BufferRef ref;
+        if (!queue_.ReceiveFromIsr(ref, yield)) return false;
+        out = pool_.Adopt(ref);
+        return true;
+    }
+
+    /**
+     * @brief Wake @p target after every successful send (see WakeTarget.h).
+     */
+    void SetWakeTarget(const WakeTarget& target) noexcept { queue_.SetWakeTarget(target); }
+
+    [[nodiscard]] static constexpr size_t Capacity() noexcept { return kDepth; }
+
+private:
+    Pool&                          pool_;
+    OsMpmcQueue<BufferRef, kDepth> queue_;
+};
+
+#endif /* BUFFER_POOL_H_ */
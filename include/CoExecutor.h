@@ -0,0 +1,504 @@
+#pragma once
+/**
+ * @file CoExecutor.h
+ * @brief C++20 coroutine executor that runs many lightweight tasks in one
+ *        `BaseThread`.
+ *
+ * A `CoTask` is a coroutine; `CoExecutor<MaxTasks, FrameBytes>::Spawn()`
+ * hands it to an event-driven `BaseThread` that resumes it whenever the thing
+ * it `co_await`s is ready. Each task costs one coroutine frame (typically
+ * tens to a few hundred bytes) instead of a full RTOS stack and TCB.
+ *
+ * Awaitables (all on `CoExecutorBase`, all return `bool` — false on timeout):
+ *   - `SleepFor(ms)` / `SleepUntil(us)` / `Yield()`
+ *   - `Receive(queue, out, timeout_ms)`       — `OsQueue` receive
+ *   - `WaitFlags(flags, bits, mode, actual, timeout_ms)` — `OsEventFlags` wait
+ *   - `WaitForChange(snapshot, timeout_ms)`   — `hf::SnapshotReader` sequence change
+ *   - `Take(semaphore, timeout_ms)`           — `SignalSemaphore`
+ *   - `WaitUntil(predicate, timeout_ms)`      — anything else
+ *
+ * The executor never blocks inside a task: on every wake it polls each
+ * suspended task's condition without waiting, resumes the ready ones, then
+ * sleeps until the next wake or the earliest timeout. Attach the executor to
+ * every primitive a task waits on, or the task only notices the event at its
+ * timeout:
+ *
+ * @code
+ * static uint8_t stack[4096];
+ * static CoExecutor<16> exec("coexec", stack, sizeof(stack), 5);
+ * static OsQueue<int, 8> inbox("inbox");
+ *
+ * CoTask Consumer(CoExecutorBase& ex) {
+ *     int v;
+ *     while (co_await ex.Receive(inbox, v, 1000)) { Handle(v); }
+ * }
+ *
+ * inbox.SetWakeTarget(exec.GetWakeTarget());
+ * exec.Spawn(Consumer(exec));
+ * exec.EnsureInitialized();
+ * exec.StartThreadAndWaitToVerify();
+ * @endcode
+ *
+ * Thread-safety: `Spawn` is safe from any task, including tasks running on
+ * the executor. Awaitables may only be `co_await`ed by tasks of the executor
+ * that created them; a task must not `co_await` any other awaitable type.
+ *
+ * Allocation: none. A task's first parameter must be the `CoExecutorBase&`
+ * it will run on (for member coroutines, the first after the object); its
+ * frame is taken from that executor's inline `MaxTasks × FrameBytes` arena.
+ * A frame that does not fit, or an exhausted arena, makes the `CoTask`
+ * invalid and `Spawn` returns false. Any other `CoTask` coroutine fails to
+ * compile rather than fall back to the heap.
+ *
+ * Only available when the compiler supports C++20 coroutines
+ * (`__cpp_impl_coroutine`); the header is empty otherwise.
+ */
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+#include "BaseThread.h"
+#include "OsQueue.h"
+#include "OsEventFlags.h"
+#include "SeqlockSnapshot.h"
+#include "SignalSemaphore.h"
+
+class CoExecutorBase;
+
+/**
+ * @class CoTask
+ * @brief Move-only owner of a not-yet-spawned coroutine.
+ *
+ * Write a task as a coroutine returning `CoTask`, then pass the result to
+ * `CoExecutorBase::Spawn()`. The coroutine does not run until the executor
+ * first resumes it; a `CoTask` that is never spawned destroys its frame.
+ */
+class CoTask {
+public:
+    struct promise_type {
+        CoTask get_return_object() noexcept
+        {
+            return CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        static CoTask get_return_object_on_allocation_failure() noexcept { return CoTask(); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_always final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::abort(); }
+
+        /** Frame from @p exec's arena: free coroutines taking `CoExecutorBase&` first. */
+        template <typename... Args>
+        static void* operator new(size_t bytes, CoExecutorBase& exec, Args&&...) noexcept;
+        /** Frame from @p exec's arena: member coroutines taking `CoExecutorBase&` first. */
+        template <typename Object, typename... Args>
+        static void* operator new(size_t bytes, Object&, CoExecutorBase& exec, Args&&...) noexcept;
+        static void operator delete(void* frame, size_t bytes) noexcept;
+    };
+
+    CoTask() noexcept = default;
+    CoTask(CoTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    CoTask& operator=(CoTask&& other) noexcept
+    {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+    ~CoTask() noexcept
+    {
+        if (handle_) handle_.destroy();
+    }
+
+    /** False if the frame could not be allocated or the task was already spawned. */
+    bool IsValid() const noexcept { return static_cast<bool>(handle_); }
+
+private:
+    friend class CoExecutorBase;
+    explicit CoTask(std::coroutine_handle<> handle) noexcept : handle_(handle) {}
+    std::coroutine_handle<> Release() noexcept { return std::exchange(handle_, {}); }
+
+    std::coroutine_handle<> handle_{};
+};
+
+/**
+ * @class CoExecutorBase
+ * @brief Size-independent part of `CoExecutor`; coroutines take a reference
+ *        to this type.
+ */
+class CoExecutorBase : public BaseThread {
+public:
+    /**
+     * @brief Condition a suspended task waits on. The executor polls it once
+     *        per pass, on the executor thread, and never while it is true.
+     */
+    class Wait {
+    public:
+        bool await_ready() noexcept { return Poll(); }
+        bool await_suspend(std::coroutine_handle<>) noexcept
+        {
+            if (exec_.Park(*this)) return true;
+            timedOut_ = true;   // not awaited from one of exec_'s tasks
+            return false;
+        }
+        bool await_resume() const noexcept { return !timedOut_; }
+
+    protected:
+        using PollFn = bool (*)(Wait&) noexcept;
+        Wait(CoExecutorBase& exec, PollFn poll, uint64_t deadlineUs) noexcept
+            : exec_(exec), poll_(poll), deadlineUs_(deadlineUs) {}
+
+    private:
+        friend class CoExecutorBase;
+        bool Poll() noexcept { return poll_(*this); }
+
+        CoExecutorBase& exec_;
+        PollFn          poll_;
+        uint64_t        deadlineUs_;
+        bool            timedOut_{false};
+    };
+
+    /**
+     * @brief `Wait` whose condition is the callable @p Pred.
+     */
+    template <typename Pred>
+    class PredicateWait : public Wait {
+    public:
+        PredicateWait(CoExecutorBase& exec, Pred pred, uint64_t deadlineUs) noexcept
+            : Wait(exec, &PredicateWait::Thunk, deadlineUs), pred_(std::move(pred)) {}
+
+    private:
+        static bool Thunk(Wait& wait) noexcept { return static_cast<PredicateWait&>(wait).pred_(); }
+        Pred pred_;
+    };
+
+    CoExecutorBase(const CoExecutorBase&) = delete;
+    CoExecutorBase& operator=(const CoExecutorBase&) = delete;
+
+    /**
+     * @brief Queue @p task to run on this executor.
+     * @return False if @p task is invalid or all task slots are in use; the
+     *         task is destroyed in that case.
+     */
+    bool Spawn(CoTask task) noexcept
+    {
+        if (!task.IsValid()) return false;
+        for (size_t i = 0; i < slotCount_; ++i) {
+            uint8_t expected = kSlotFree;
+            if (slots_[i].state.compare_exchange_strong(expected, kSlotClaimed,
+                                                        std::memory_order_acquire)) {
+                slots_[i].handle = task.Release();
+                slots_[i].wait   = nullptr;
+                slots_[i].state.store(kSlotLive, std::memory_order_release);
+                liveTasks_.fetch_add(1, std::memory_order_relaxed);
+                (void)Wake();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Number of spawned tasks that have not finished yet. */
+    size_t LiveTasks() const noexcept { return liveTasks_.load(std::memory_order_relaxed); }
+
+    /** Maximum number of concurrent tasks. */
+    size_t Capacity() const noexcept { return slotCount_; }
+
+    /** Suspend until `os_time_get_us()` reaches @p deadlineUs. Always returns false. */
+    auto SleepUntil(uint64_t deadlineUs) noexcept
+    {
+        return PredicateWait<Never>(*this, Never{}, deadlineUs);
+    }
+
+    /** Suspend until @p ms milliseconds from now. Always returns false. */
+    auto SleepFor(uint32_t ms) noexcept
+    {
+        return SleepUntil(os_time_get_us() + static_cast<uint64_t>(ms) * 1000U);
+    }
+
+    /** Let every other ready task run once, then continue. */
+    auto Yield() noexcept
+    {
+        return PredicateWait<Once>(*this, Once{}, kNoDeadline);
+    }
+
+    /**
+     * @brief Suspend until @p pred returns true or @p timeoutMs elapses.
+     *
+     * @p pred runs on the executor thread, must not block, and is captured by
+     * value (capture references to outlive the wait).
+     */
+    template <typename Pred>
+    auto WaitUntil(Pred pred, uint32_t timeoutMs = UINT32_MAX) noexcept
+    {
+        return PredicateWait<Pred>(*this, std::move(pred), DeadlineAfter(timeoutMs));
+    }
+
+    /** `co_await` form of `OsQueue::Receive`. */
+    template <typename T, size_t N>
+    auto Receive(OsQueue<T, N>& queue, T& out, uint32_t timeoutMs = UINT32_MAX) noexcept
+    {
+        return WaitUntil([&queue, &out]() noexcept { return queue.Receive(out, 0); }, timeoutMs);
+    }
+
+    /** `co_await` form of `OsEventFlags::Wait`; @p actual holds the bits seen on success. */
+    template <size_t R>
+    auto WaitFlags(OsEventFlags<R>& flags, uint32_t bits, WaitMode mode, uint32_t& actual,
+                   uint32_t timeoutMs = UINT32_MAX) noexcept
+    {
+        return WaitUntil([&flags, bits, mode, &actual]() noexcept {
+            return flags.Wait(bits, mode, 0, actual);
+        }, timeoutMs);
+    }
+
+    /** Suspend until @p snapshot is published again after this call. */
+    template <typename T>
+    auto WaitForChange(const hf::SnapshotReader<T>& snapshot, uint32_t timeoutMs = UINT32_MAX) noexcept
+    {
+        const uint32_t seen = snapshot.Seq();
+        return WaitUntil([&snapshot, seen]() noexcept { return snapshot.Seq() != seen; }, timeoutMs);
+    }
+
+    /**
+     * @brief `co_await` form of `SignalSemaphore::WaitUntilSignalled`. In
+     *        `Mode::TaskNotify` the executor thread becomes the bound waiter.
+     */
+    auto Take(SignalSemaphore& semaphore, uint32_t timeoutMs = UINT32_MAX) noexcept
+    {
+        return WaitUntil([&semaphore]() noexcept { return semaphore.WaitUntilSignalled(0); }, timeoutMs);
+    }
+
+    bool Setup() noexcept override { return true; }
+    bool Cleanup() noexcept override { return true; }
+
+    /**
+     * @brief One pass: resume every task whose condition holds or whose
+     *        timeout expired.
+     * @return 0 if any task ran (another may now be ready), otherwise the ms
+     *         to the earliest timeout, or UINT32_MAX to sleep until woken.
+     */
+    uint32_t Step() noexcept override
+    {
+        const uint64_t now = os_time_get_us();
+        uint64_t nextDeadline = kNoDeadline;
+        bool ran = false;
+
+        for (size_t i = 0; i < slotCount_; ++i) {
+            Slot& slot = slots_[i];
+            if (slot.state.load(std::memory_order_acquire) != kSlotLive) continue;
+
+            if (slot.wait != nullptr) {
+                Wait& wait = *slot.wait;
+                if (!wait.Poll()) {
+                    if (wait.deadlineUs_ > now) {
+                        if (wait.deadlineUs_ < nextDeadline) nextDeadline = wait.deadlineUs_;
+                        continue;
+                    }
+                    wait.timedOut_ = true;
+                }
+                slot.wait = nullptr;
+            }
+
+            current_ = i;
+            slot.handle.resume();
+            current_ = kNoSlot;
+            ran = true;
+
+            if (slot.handle.done()) {
+                slot.handle.destroy();
+                slot.handle = {};
+                slot.state.store(kSlotFree, std::memory_order_release);
+                liveTasks_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (ran) return 0;
+        if (nextDeadline == kNoDeadline) return UINT32_MAX;
+        const uint64_t waitMs = (nextDeadline - now + 999U) / 1000U;
+        return (waitMs < UINT32_MAX) ? static_cast<uint32_t>(waitMs) : UINT32_MAX - 1U;
+    }
+
+protected:
+    static constexpr size_t kFrameAlign  = alignof(std::max_align_t);
+    static constexpr size_t kFrameHeader = kFrameAlign;   ///< Holds the owning executor.
+
+    /** One task slot; `state` publishes `handle` from Spawn() to the executor thread. */
+    struct Slot {
+        std::atomic<uint8_t>    state{0};
+        std::coroutine_handle<> handle{};
+        Wait*                   wait{nullptr};
+    };
+
+    /**
+     * @param slots      `slotCount` task slots.
+     * @param frames     `slotCount` arena blocks of `blockBytes` each, `kFrameAlign`-aligned.
+     * @param frameUsed  `slotCount` arena block flags.
+     */
+    CoExecutorBase(const char* name, uint8_t* stack, uint32_t stackBytes, OS_Uint priority,
+                   int coreId, Slot* slots, size_t slotCount, uint8_t* frames,
+                   std::atomic<bool>* frameUsed, size_t blockBytes) noexcept
+        : BaseThread(name),
+          slots_(slots), slotCount_(slotCount), frames_(frames), frameUsed_(frameUsed),
+          blockBytes_(blockBytes), stack_(stack), stackBytes_(stackBytes),
+          priority_(priority), coreId_(coreId)
+    {
+        (void)SetScheduleMode(ScheduleMode::EventDriven);
+    }
+
+    bool Initialize() noexcept override
+    {
+        return CreateBaseThread(stack_, stackBytes_, priority_, 0, 0, OS_AUTO_START, coreId_);
+    }
+
+    bool ResetVariables() noexcept override { return true; }
+
+    /** Destroy every unfinished task; the executor thread must not be running. */
+    void DestroyTasks() noexcept
+    {
+        for (size_t i = 0; i < slotCount_; ++i) {
+            if (slots_[i].state.load(std::memory_order_acquire) == kSlotLive) {
+                slots_[i].handle.destroy();
+                slots_[i].state.store(kSlotFree, std::memory_order_release);
+                liveTasks_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    friend struct CoTask::promise_type;
+
+    static constexpr uint8_t  kSlotFree    = 0;
+    static constexpr uint8_t  kSlotClaimed = 1;
+    static constexpr uint8_t  kSlotLive    = 2;
+    static constexpr size_t   kNoSlot      = SIZE_MAX;
+    static constexpr uint64_t kNoDeadline  = UINT64_MAX;
+
+    struct Never {
+        bool operator()() const noexcept { return false; }
+    };
+    struct Once {
+        bool polled = false;
+        bool operator()() noexcept { return std::exchange(polled, true); }
+    };
+
+    static uint64_t DeadlineAfter(uint32_t timeoutMs) noexcept
+    {
+        if (timeoutMs == UINT32_MAX) return kNoDeadline;
+        return os_time_get_us() + static_cast<uint64_t>(timeoutMs) * 1000U;
+    }
+
+    /** Record @p wait for the task being resumed; false if none is. */
+    bool Park(Wait& wait) noexcept
+    {
+        if (current_ == kNoSlot || &wait.exec_ != this) return false;
+        slots_[current_].wait = &wait;
+        return true;
+    }
+
+    /** Arena block with room for @p bytes plus the header, or nullptr. */
+    void* AllocateFrame(size_t bytes) noexcept
+    {
+        if (bytes + kFrameHeader > blockBytes_) return nullptr;
+        for (size_t i = 0; i < slotCount_; ++i) {
+            bool expected = false;
+            if (frameUsed_[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return frames_ + i * blockBytes_;
+            }
+        }
+        return nullptr;
+    }
+
+    void FreeFrame(void* block) noexcept
+    {
+        const size_t index = static_cast<size_t>(static_cast<uint8_t*>(block) - frames_) / blockBytes_;
+        frameUsed_[index].store(false, std::memory_order_release);
+    }
+
+    Slot*               slots_;
+    size_t              slotCount_;
+    uint8_t*            frames_;
+    std::atomic<bool>*  frameUsed_;
+    size_t              blockBytes_;
+    uint8_t*            stack_;
+    uint32_t            stackBytes_;
+    OS_Uint             priority_;
+    int                 coreId_;
+    size_t              current_{kNoSlot};
+    std::atomic<size_t> liveTasks_{0};
+};
+
+template <typename... Args>
+void* CoTask::promise_type::operator new(size_t bytes, CoExecutorBase& exec, Args&&...) noexcept
+{
+    auto* block = static_cast<uint8_t*>(exec.AllocateFrame(bytes));
+    if (block == nullptr) return nullptr;
+    *reinterpret_cast<CoExecutorBase**>(block) = &exec;
+    return block + CoExecutorBase::kFrameHeader;
+}
+
+template <typename Object, typename... Args>
+void* CoTask::promise_type::operator new(size_t bytes, Object&, CoExecutorBase& exec, Args&&...) noexcept
+{
+    return operator new(bytes, exec);
+}
+
+inline void CoTask::promise_type::operator delete(void* frame, size_t) noexcept
+{
+    auto* block = static_cast<uint8_t*>(frame) - CoExecutorBase::kFrameHeader;
+    (*reinterpret_cast<CoExecutorBase**>(block))->FreeFrame(block);
+}
+
+/**
+ * @class CoExecutor
+ * @brief `CoExecutorBase` with inline storage for @p MaxTasks tasks.
+ *
+ * @tparam MaxTasks    Maximum number of concurrent tasks.
+ * @tparam FrameBytes  Largest coroutine frame the arena accepts; the compiler
+ *                     decides each frame's size, so size this from a test
+ *                     `Spawn` (it fails when a frame does not fit).
+ */
+template <size_t MaxTasks, size_t FrameBytes = 256>
+class CoExecutor : public CoExecutorBase {
+    static_assert(MaxTasks > 0, "CoExecutor needs at least one task slot");
+
+public:
+    /**
+     * @param name        Thread name.
+     * @param stack       Caller-owned stack for the executor thread.
+     * @param stackBytes  Size of @p stack; every task runs on it.
+     * @param priority    Thread priority.
+     * @param coreId      Core to pin the thread to, or -1 for no affinity.
+     */
+    CoExecutor(const char* name, uint8_t* stack, uint32_t stackBytes, OS_Uint priority,
+               int coreId = -1) noexcept
+        : CoExecutorBase(name, stack, stackBytes, priority, coreId, slots_, MaxTasks,
+                         &frames_[0][0], frameUsed_, kBlockBytes) {}
+
+    /// Stops the executor thread first: it must not resume a task, or call
+    /// Step() through this half-destroyed object, while the frames go away.
+    ~CoExecutor() noexcept override
+    {
+        if (IsThreadRunning()) {
+            (void)StopThreadAndWaitToVerify(1000);
+        }
+        DestroyTasks();
+    }
+
+private:
+    static constexpr size_t kBlockBytes =
+        kFrameHeader + (FrameBytes + kFrameAlign - 1U) / kFrameAlign * kFrameAlign;
+
+    Slot              slots_[MaxTasks];
+    std::atomic<bool> frameUsed_[MaxTasks]{};
+    alignas(kFrameAlign) uint8_t frames_[MaxTasks][kBlockBytes];
+};
+
+#endif /* __cpp_impl_coroutine */
@@ -0,0 +1,112 @@
+/**
+ * @file CpuUsage.h
+ * @brief Sliding-window CPU share computed from a cumulative busy-time counter.
+ *
+ * Feed `CpuUsageWindow::Sample()` the running CPU-time counter of a thread
+ * (`os_thread_cpu_time_get`) or of a core's idle task
+ * (`os_core_idle_time_get`) at a fixed period — once per second gives the
+ * 1 s (`shortPermille`) and 10 s (`longPermille`) windows. Each sample is
+ * O(1): one ring-slot write and two subtractions. Shares are in permille of
+ * one core.
+ *
+ * Thread-safety: single sampler; `Get()` is lock-free from any task.
+ *
+ * Allocation: none; `kLongWindowSamples + 1` slots inline (~100 bytes).
+ *
+ * @todo Add @copyright line once project copyright wording is finalised.
+ */
+
+#ifndef HF_UTILS_RTOS_WRAP_CPUUSAGE_H_
+#define HF_UTILS_RTOS_WRAP_CPUUSAGE_H_
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Upper bound on cores tracked by the per-core idle accounting.
+ */
+#ifndef HF_RTOS_MAX_CORES
+#define HF_RTOS_MAX_CORES 2
+#endif
+
+//==============================================================//
+// CLASS
+//==============================================================//
+class CpuUsageWindow
+{
+	public:
+		/** Samples spanned by the long window; 10 at a 1 s sampling period. */
+		static constexpr uint32_t kLongWindowSamples = 10;
+
+		struct Usage {
+			uint16_t shortPermille;	/**< Share over the latest sample interval. */
+			uint16_t longPermille;	/**< Share over up to kLongWindowSamples intervals. */
+		};
+
+		CpuUsageWindow() noexcept = default;
+
+		CpuUsageWindow(const CpuUsageWindow&) = delete;
+		CpuUsageWindow& operator = (const CpuUsageWindow&) = delete;
+
+		/**
+		 * @brief Record a cumulative counter reading.
+		 * @param busyUs  Cumulative CPU time in microseconds; may wrap at 2^32.
+		 * @param nowUs   Wall time in microseconds (low 32 bits of os_time_get_us()).
+		 */
+		void Sample(uint32_t busyUs, uint32_t nowUs) noexcept
+		{
+			head = (head + 1U) % kSlots;
+			busy[head] = busyUs;
+			at[head] = nowUs;
+			if(count < kSlots) {
+				++count;
+			}
+			if(count < 2U) {
+				return;
+			}
+
+			const uint32_t previous = (head + kSlots - 1U) % kSlots;
+			const uint32_t oldest = (head + kSlots - (count - 1U)) % kSlots;
+			const uint32_t shortPermille = Permille(busyUs - busy[previous], nowUs - at[previous]);
+			const uint32_t longPermille = Permille(busyUs - busy[oldest], nowUs - at[oldest]);
+			packed.store(shortPermille | (longPermille << 16), std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Latest shares; zero until two samples were recorded.
+		 */
+		Usage Get() const noexcept
+		{
+			const uint32_t value = packed.load(std::memory_order_relaxed);
+			return Usage{ static_cast<uint16_t>(value & 0xFFFFU), static_cast<uint16_t>(value >> 16) };
+		}
+
+		/**
+		 * @brief Drop the history, e.g. after the counter source was recreated.
+		 */
+		void Reset() noexcept
+		{
+			count = 0;
+			packed.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		static constexpr uint32_t kSlots = kLongWindowSamples + 1U;
+
+		static uint32_t Permille(uint32_t busyDeltaUs, uint32_t wallDeltaUs) noexcept
+		{
+			if(wallDeltaUs == 0U) {
+				return 0U;
+			}
+			const uint64_t permille = (static_cast<uint64_t>(busyDeltaUs) * 1000U) / wallDeltaUs;
+			return (permille > 1000U) ? 1000U : static_cast<uint32_t>(permille);
+		}
+
+		uint32_t busy[kSlots] = {};
+		uint32_t at[kSlots] = {};
+		uint32_t head = 0;
+		uint32_t count = 0;
+		std::atomic<uint32_t> packed{0};	/**< shortPermille | longPermille << 16. */
+};
+
+#endif /* HF_UTILS_RTOS_WRAP_CPUUSAGE_H_ */
@@ -0,0 +1,492 @@
+/**
+ * @file FixedBaseThreadsManager.h
+ * @brief Allocation-free registry that starts / stops a group of
+ *        `BaseThread` instances together.
+ *
+ * Same lifecycle surface as `BaseThreadsManager`, but threads live in a
+ * `std::array<BaseThread*, N>` indexed by the enum value and selections are
+ * `std::bitset<N>` masks, so lookups are array indexing and "all except"
+ * is a bitwise complement. Build masks with `Select(kA, kB, ...)`.
+ *
+ * Thread-safety: the lifecycle calls are serialized by an internal mutex;
+ * callers may start / stop from any task context. The registry is fixed at
+ * construction, so the query calls take no lock.
+ *
+ * Allocation: none, at construction or on any call — usable from boot paths
+ * before the heap is set up when built with `HF_RTOS_STATIC_ALLOCATION`
+ * (otherwise the internal mutex allocates its handle once). The caller owns
+ * the threads and their stacks.
+ *
+ * @todo Add @copyright line once project copyright wording is finalised.
+ */
+
+#ifndef HF_UTILS_RTOS_WRAP_FIXEDBASETHREADSMANAGER_H_
+#define HF_UTILS_RTOS_WRAP_FIXEDBASETHREADSMANAGER_H_
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+#include "OsAbstraction.h"
+
+#include "OsUtility.h"
+#include "BaseThread.h"
+#include "Mutex.h"
+#include "MutexGuard.h"
+
+//==============================================================//
+// CLASS
+//==============================================================//
+/**
+ * @tparam EnumType  Thread id; plain enum or `enum class` with values 0 .. MaxCount-1.
+ * @tparam MaxCount  Number of ids (the enum's count sentinel).
+ */
+template <typename EnumType, EnumType MaxCount> class FixedBaseThreadsManager
+{
+	public:
+		static constexpr size_t Count = static_cast<size_t>(MaxCount);
+
+		using Mask = std::bitset<Count>;
+		using ThreadArray = std::array<BaseThread*, Count>;
+		using EnumToStringFunc = const char* (*)(EnumType);
+
+		/**
+		 * @param threads           Thread for each id; nullptr for ids not managed.
+		 * @param enumToStringFunc  Optional name lookup for GetThreadIdName().
+		 */
+		explicit FixedBaseThreadsManager(const ThreadArray& threads, EnumToStringFunc enumToStringFunc = nullptr) noexcept;
+
+		/**
+		  * @brief The Copy constructor is deleted to avoid copying instances.
+	  	  * @return n/a
+		  */
+		FixedBaseThreadsManager(const FixedBaseThreadsManager&) = delete;
+
+	    /**
+	      * @brief  The assignment operator constructor is deleted to avoid copying instances.
+	      * @return n/a
+		  */
+		FixedBaseThreadsManager& operator = (const FixedBaseThreadsManager&) = delete;
+
+		virtual ~FixedBaseThreadsManager() = default;
+
+		/**
+		 * @brief Mask with the bits of @p ids set.
+		 */
+		template <typename... Ids>
+		static Mask Select(Ids... ids) noexcept
+		{
+			Mask mask;
+			(mask.set(static_cast<size_t>(ids)), ...);
+			return mask;
+		}
+
+		bool EnsureInitialized() noexcept;
+
+		bool ResumeAll() noexcept;
+
+		bool ResumeSelected(const Mask& selected) noexcept;
+
+		bool StartAll() noexcept;
+
+		bool StartSelected(const Mask& selected) noexcept;
+
+		bool StartAllExceptSelected(const Mask& selected) noexcept;
+
+		bool StartAllAndWaitToVerify(uint32_t waitToVerifyTimeoutMsec) noexcept;
+
+		bool StartSelectedAndWaitToVerify(const Mask& selected, uint32_t waitToVerifyTimeoutMsec) noexcept;
+
+		bool StartAllExceptSelectedAndWaitToVerify(const Mask& selected, uint32_t waitToVerifyTimeoutMsec) noexcept;
+
+		bool StopAll() noexcept;
+
+		bool StopSelected(const Mask& selected) noexcept;
+
+		bool StopAllExceptSelected(const Mask& selected) noexcept;
+
+		bool StopAllAndWaitToVerify(uint32_t waitToVerifyTimeoutMsec) noexcept;
+
+		bool StopSelectedAndWaitToVerify(const Mask& selected, uint32_t waitToVerifyTimeoutMsec) noexcept;
+
+		bool StopAllExceptSelectedAndWaitToVerify(const Mask& selected, uint32_t waitToVerifyTimeoutMsec) noexcept;
+
+		/**
+		 * @brief Ids that have a thread.
+		 */
+		const Mask& GetManagedMask() const noexcept { return threadsManagedMask; }
+
+		/**
+		 * @brief Thread registered for @p threadId, or nullptr.
+		 */
+		BaseThread* GetThread(EnumType threadId) const noexcept;
+
+		/**
+		 * @brief Name of @p threadId from the enum-to-string function, or nullptr.
+		 */
+		const char* GetThreadIdName(EnumType threadId) const noexcept;
+
+		/**
+		 * @brief Copy the deadline counters of one managed thread.
+		 * @return False if @p threadId is not managed.
+		 */
+		bool GetDeadlineStats(EnumType threadId, BaseThread::DeadlineStats& stats) const noexcept;
+
+		/**
+		 * @brief Sum of the deadline misses of every managed thread.
+		 */
+		uint32_t GetTotalDeadlineMisses() const noexcept;
+
+		virtual bool PreThreadInitializationActions() noexcept;
+
+		virtual bool PostThreadInitializationActions() noexcept;
+
+	private:
+
+		/**
+		 * @brief Initializes every managed thread.
+		 * @return True if the initialization is successful, false otherwise.
+		 */
+		bool Initialize() noexcept;
+
+		/**
+		 * @brief Resume / start / stop every managed thread in @p targets.
+		 * @return True if the call succeeded for all of them.
+		 */
+		bool ResumeMask(const Mask& targets) noexcept;
+		bool StartMask(const Mask& targets) noexcept;
+		bool StopMask(const Mask& targets) noexcept;
+
+		/**
+		 * @brief Block until every managed thread in @p targets reports
+		 *        running (or stopped), sharing one deadline across all of them.
+		 * @param running  True to wait for running, false to wait for stopped.
+		 * @return True if every targeted thread reached the state in time.
+		 */
+		bool WaitForMask(bool running, const Mask& targets, uint32_t waitToVerifyTimeoutMsec) noexcept;
+
+		bool initialized; /**< Flag indicating if the manager is initialized. */
+
+		Mutex mutex;
+		static const char mutexName[];
+
+		ThreadArray threadsManaged;
+		Mask threadsManagedMask;
+		EnumToStringFunc enumToString;
+
+		Mask threadsInitializedTracker;
+		Mask threadsStartedTracker;
+		Mask threadsStoppedTracker;
+};
+
+
+template <typename EnumType, EnumType MaxCount>
+FixedBaseThreadsManager<EnumType, MaxCount>::FixedBaseThreadsManager(const ThreadArray& threads, EnumToStringFunc enumToStringFunc) noexcept :
+	initialized(false),
+	mutex(mutexName),
+	threadsManaged(threads),
+	threadsManagedMask(),
+	enumToString(enumToStringFunc),
+	threadsInitializedTracker(),
+	threadsStartedTracker(),
+	threadsStoppedTracker()
+{
+	for(size_t i = 0; i < Count; ++i) {
+		threadsManagedMask[i] = (threadsManaged[i] != nullptr);
+	}
+}
+
+/**
+ * @brief Ensures that the manager is initialized.
+ *
+ * @return true if the manager is initialized, false otherwise.
+ */
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::EnsureInitialized() noexcept
+{
+	if (!initialized)
+	{
+		initialized = Initialize();
+	}
+	return initialized;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::ResumeAll() noexcept
+{
+	return ResumeMask(threadsManagedMask);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::ResumeSelected(const Mask& selected) noexcept
+{
+	return ResumeMask(selected);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StartAll() noexcept
+{
+	return StartMask(threadsManagedMask);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StartSelected(const Mask& selected) noexcept
+{
+	return StartMask(selected);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StartAllExceptSelected(const Mask& selected) noexcept
+{
+	return StartMask(~selected);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StartAllAndWaitToVerify(uint32_t waitToVerifyTimeoutMsec) noexcept
+{
+	return StartSelectedAndWaitToVerify(threadsManagedMask, waitToVerifyTimeoutMsec);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StartSelectedAndWaitToVerify(const Mask& selected, uint32_t waitToVerifyTimeoutMsec) noexcept
+{
+	if (EnsureInitialized() )
+	{
+		MutexGuard guard(mutex);
+
+		const Mask targets = selected & threadsManagedMask;
+		for(size_t i = 0; i < Count; ++i) {
+			if(targets[i]) {
+				threadsManaged[i]->Start();
+			}
+		}
+
+		/// Block on each thread's RUNNING / STOPPED event bit, sharing one deadline
+		return WaitForMask(true, targets, waitToVerifyTimeoutMsec);
+	}
+
+	return false;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StartAllExceptSelectedAndWaitToVerify(const Mask& selected, uint32_t waitToVerifyTimeoutMsec) noexcept
+{
+	return StartSelectedAndWaitToVerify(~selected, waitToVerifyTimeoutMsec);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StopAll() noexcept
+{
+	return StopMask(threadsManagedMask);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StopSelected(const Mask& selected) noexcept
+{
+	return StopMask(selected);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StopAllExceptSelected(const Mask& selected) noexcept
+{
+	return StopMask(~selected);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StopAllAndWaitToVerify(uint32_t waitToVerifyTimeoutMsec) noexcept
+{
+	return StopSelectedAndWaitToVerify(threadsManagedMask, waitToVerifyTimeoutMsec);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StopSelectedAndWaitToVerify(const Mask& selected, uint32_t waitToVerifyTimeoutMsec) noexcept
+{
+	if (EnsureInitialized() )
+	{
+		MutexGuard guard(mutex);
+
+		const Mask targets = selected & threadsManagedMask;
+		for(size_t i = 0; i < Count; ++i) {
+			if(targets[i]) {
+				threadsManaged[i]->Stop();
+			}
+		}
+
+		/// Block on each thread's RUNNING / STOPPED event bit, sharing one deadline
+		return WaitForMask(false, targets, waitToVerifyTimeoutMsec);
+	}
+
+	return false;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StopAllExceptSelectedAndWaitToVerify(const Mask& selected, uint32_t waitToVerifyTimeoutMsec) noexcept
+{
+	return StopSelectedAndWaitToVerify(~selected, waitToVerifyTimeoutMsec);
+}
+
+template <typename EnumType, EnumType MaxCount>
+BaseThread* FixedBaseThreadsManager<EnumType, MaxCount>::GetThread(EnumType threadId) const noexcept
+{
+	const size_t index = static_cast<size_t>(threadId);
+	return (index < Count) ? threadsManaged[index] : nullptr;
+}
+
+template <typename EnumType, EnumType MaxCount>
+const char* FixedBaseThreadsManager<EnumType, MaxCount>::GetThreadIdName(EnumType threadId) const noexcept
+{
+	return (enumToString != nullptr) ? enumToString(threadId) : nullptr;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::GetDeadlineStats(EnumType threadId, BaseThread::DeadlineStats& stats) const noexcept
+{
+	/// The registry is fixed at construction and the counters are atomics, so no lock is needed.
+	const BaseThread* thread = GetThread(threadId);
+	if(thread == nullptr) {
+		return false;
+	}
+	stats = thread->GetDeadlineStats();
+	return true;
+}
+
+template <typename EnumType, EnumType MaxCount>
+uint32_t FixedBaseThreadsManager<EnumType, MaxCount>::GetTotalDeadlineMisses() const noexcept
+{
+	uint32_t misses = 0;
+	for(const BaseThread* thread : threadsManaged) {
+		if(thread != nullptr) {
+			misses += thread->GetDeadlineStats().misses;
+		}
+	}
+	return misses;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::PreThreadInitializationActions() noexcept {
+	return true;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::PostThreadInitializationActions() noexcept {
+	return true;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::Initialize() noexcept
+{
+	bool success = false;
+	MutexGuard guard(mutex, &success);
+
+	if( success )
+	{
+		/// If pre thread initialization actions fail, return false
+		if( !PreThreadInitializationActions() ) { return false; }
+
+		for(size_t i = 0; i < Count; ++i) {
+			if(threadsManagedMask[i]) {
+				threadsInitializedTracker[i] = threadsManaged[i]->EnsureInitialized();
+			}
+		}
+
+		/// If post thread initialization actions fail, return false
+		if( !PostThreadInitializationActions() ) { return false; }
+	}
+	return success && (threadsInitializedTracker == threadsManagedMask);
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::ResumeMask(const Mask& targets) noexcept
+{
+	if (EnsureInitialized() )
+	{
+		MutexGuard guard(mutex);
+
+		bool allResumed = true;
+		for(size_t i = 0; i < Count; ++i) {
+			if(targets[i] && threadsManagedMask[i]) {
+				allResumed = threadsManaged[i]->Resume() && allResumed;
+			}
+		}
+		return allResumed;
+	}
+
+	return false;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StartMask(const Mask& targets) noexcept
+{
+	if (EnsureInitialized() )
+	{
+		MutexGuard guard(mutex);
+
+		bool allStarted = true;
+		for(size_t i = 0; i < Count; ++i) {
+			if(targets[i] && threadsManagedMask[i]) {
+				const bool started = threadsManaged[i]->Start();
+				threadsStartedTracker[i] = started;
+				allStarted = allStarted && started;
+			}
+		}
+		return allStarted;
+	}
+
+	return false;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::StopMask(const Mask& targets) noexcept
+{
+	if (EnsureInitialized() )
+	{
+		MutexGuard guard(mutex);
+
+		bool allStopped = true;
+		for(size_t i = 0; i < Count; ++i) {
+			if(targets[i] && threadsManagedMask[i]) {
+				const bool stopped = threadsManaged[i]->Stop();
+				threadsStoppedTracker[i] = stopped;
+				allStopped = allStopped && stopped;
+			}
+		}
+		return allStopped;
+	}
+
+	return false;
+}
+
+template <typename EnumType, EnumType MaxCount>
+bool FixedBaseThreadsManager<EnumType, MaxCount>::WaitForMask(bool running, const Mask& targets, uint32_t waitToVerifyTimeoutMsec) noexcept
+{
+	const uint64_t deadlineUs = os_time_get_us() + static_cast<uint64_t>(waitToVerifyTimeoutMsec) * 1000ULL;
+
+	bool result = true;
+	for(size_t i = 0; i < Count; ++i) {
+		if(!targets[i]) {
+			continue;
+		}
+
+		uint32_t remainingMsec = UINT32_MAX;
+		if(waitToVerifyTimeoutMsec != UINT32_MAX) {
+			const uint64_t nowUs = os_time_get_us();
+			remainingMsec = (nowUs < deadlineUs) ? static_cast<uint32_t>((deadlineUs - nowUs + 999U) / 1000U) : 0U;
+		}
+
+		const bool reached = running ? threadsManaged[i]->WaitUntilRunning(remainingMsec)
+		                             : threadsManaged[i]->WaitUntilStopped(remainingMsec);
+		if(running) {
+			threadsStartedTracker[i] = reached;
+		} else {
+			threadsStoppedTracker[i] = reached;
+		}
+		result = result && reached;
+	}
+	return result;
+}
+
+template <typename EnumType, EnumType MaxCount>
+const char FixedBaseThreadsManager<EnumType, MaxCount>::mutexName[] = "FixedThreadManager-Mutex";
+
+#endif /* HF_UTILS_RTOS_WRAP_FIXEDBASETHREADSMANAGER_H_ */
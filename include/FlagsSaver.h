@@ -18,14 +18,15 @@
  *   and signals a single bit on a lazily-created `OsEventFlags`.
  *
  * @par Thread-safety
- *   - Set / Clear / IsSet / Snapshot / Seq / LastChangeMs: lock-free; safe
+ *   - Set / Clear / IsSet / Snapshot / Seq / LastChange*: lock-free; safe
  *     from any task context. Not ISR-safe (FreeRTOS event-group set is not
  *     ISR-safe via this path).
  *   - WaitForChange: backed by a FreeRTOS event group; do not call from ISR.
  *
  * @par Allocation
  *   No heap allocation. Storage is a fixed-size atomic word array sized at
- *   compile time. The event group is created on first use.
+ *   compile time. The event group is created on first use (in an inline
+ *   control block under `HF_RTOS_STATIC_ALLOCATION`).
  */
 #ifndef HF_UTILS_RTOS_WRAP_FLAGSSAVER_H_
 #define HF_UTILS_RTOS_WRAP_FLAGSSAVER_H_
@@ -36,6 +37,7 @@
 #include <cstdint>
 
 #include "OsAbstraction.h"
+#include "WakeTarget.h"
 
 namespace hf {
 
@@ -50,6 +52,7 @@ struct FlagsSnapshot {
     uint64_t bits[kWordCount > 0 ? kWordCount : 1]{};
     uint32_t seq{0};
     uint32_t last_change_ms{0};
+    uint64_t last_change_us{0};
 };
 
 /**
@@ -74,9 +77,13 @@ public:
     /// actually toggled state.
     [[nodiscard]] virtual uint32_t Seq() const noexcept = 0;
 
-    /// Most recent `now_ms` value passed to `Set` / `Clear` (0 if never).
+    /// Most recent `now_ms` value passed to `Set` / `Clear`, or the
+    /// monotonic clock in ms when the writer passed 0 (0 if never changed).
     [[nodiscard]] virtual uint32_t LastChangeMs() const noexcept = 0;
 
+    /// `os_time_get_us()` at the most recent transition (0 if never).
+    [[nodiscard]] virtual uint64_t LastChangeUs() const noexcept = 0;
+
     /**
      * @brief Block up to @p timeout_ms waiting for any change since the
      *        last call to `WaitForChange` or `ClearWaitEvent`.
@@ -100,7 +107,8 @@ public:
      * @brief Mark @p id set. Idempotent: returns `false` if state was
      *        already `Set` (no event signalled).
      * @param now_ms Optional timestamp recorded as `LastChangeMs()` when
-     *               the bit actually transitioned. Pass 0 to skip.
+     *               the bit actually transitioned. Pass 0 to stamp from the
+     *               monotonic clock instead.
      */
     virtual bool Set(FlagId id, uint32_t now_ms = 0) noexcept = 0;
 
@@ -164,7 +172,7 @@ public:
             if (prev != 0U) changed = true;
         }
         if (!changed) return false;
-        if (now_ms != 0U) last_change_ms_.store(now_ms, std::memory_order_release);
+        StampChange_(now_ms);
         SignalChange_();
         return true;
     }
@@ -188,6 +196,7 @@ public:
         }
         out.seq            = seq_.load(std::memory_order_acquire);
         out.last_change_ms = last_change_ms_.load(std::memory_order_acquire);
+        out.last_change_us = last_change_us_.load(std::memory_order_acquire);
     }
 
     [[nodiscard]] uint32_t Seq() const noexcept override
@@ -200,6 +209,11 @@ public:
         return last_change_ms_.load(std::memory_order_acquire);
     }
 
+    [[nodiscard]] uint64_t LastChangeUs() const noexcept override
+    {
+        return last_change_us_.load(std::memory_order_acquire);
+    }
+
     bool WaitForChange(uint32_t timeout_ms) noexcept override
     {
         if (!EnsureEventGroup_()) return false;
@@ -219,6 +233,12 @@ public:
         return os_event_group_clear(&event_group_, kEventBit_) == OS_SUCCESS;
     }
 
+    /**
+     * @brief Wake @p target after every change. Attach before the first
+     *        write; pass an empty WakeTarget to detach.
+     */
+    void SetWakeTarget(const WakeTarget& target) noexcept { wake_ = target; }
+
 private:
     bool WriteSlot_(FlagId id, bool set, uint32_t now_ms) noexcept
     {
@@ -236,23 +256,36 @@ private:
         const bool was_set = (prev & mask) != 0U;
         if (was_set == set) return false;  // no transition
 
-        if (now_ms != 0U) last_change_ms_.store(now_ms, std::memory_order_release);
+        StampChange_(now_ms);
         SignalChange_();
         return true;
     }
 
+    void StampChange_(uint32_t now_ms) noexcept
+    {
+        const uint64_t now_us = os_time_get_us();
+        last_change_us_.store(now_us, std::memory_order_release);
+        last_change_ms_.store(now_ms != 0U ? now_ms : static_cast<uint32_t>(now_us / 1000U),
+                              std::memory_order_release);
+    }
+
     void SignalChange_() noexcept
     {
         seq_.fetch_add(1, std::memory_order_acq_rel);
         if (EnsureEventGroup_()) {
             (void)os_event_group_set(&event_group_, kEventBit_);
         }
+        (void)wake_.Signal();
     }
 
     bool EnsureEventGroup_() noexcept
     {
         if (event_group_created_) return true;
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+        if (os_event_group_create_static(&event_group_, &event_group_storage_, "FlagsSaver") == OS_SUCCESS) {
+#else
         if (os_event_group_create(&event_group_, "FlagsSaver") == OS_SUCCESS) {
+#endif
             event_group_created_ = true;
         }
         return event_group_created_;
@@ -263,7 +296,12 @@ private:
     std::atomic<uint64_t> words_[kWordCount]{};
     std::atomic<uint32_t> seq_{0};
     std::atomic<uint32_t> last_change_ms_{0};
+    std::atomic<uint64_t> last_change_us_{0};
     OS_EventGroup         event_group_{};
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_EventGroupStorage  event_group_storage_{};
+#endif
+    WakeTarget            wake_{};
     bool                  event_group_created_{false};
 };
 
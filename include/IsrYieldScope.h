@@ -0,0 +1,45 @@
+#pragma once
+/**
+ * @file IsrYieldScope.h
+ * @brief RAII collector for the "higher priority task woken" flag in ISRs.
+ *
+ * Declare one at the top of an interrupt handler and pass it to every
+ * `...FromIsr` call; a single `portYIELD_FROM_ISR` is issued when the scope
+ * ends instead of one per call.
+ *
+ * Thread-safety: interrupt context only; one scope per handler invocation.
+ *
+ * Allocation: none.
+ *
+ * @code
+ * void IRAM_ATTR OnAdcDone(void*) {
+ *     IsrYieldScope yield;
+ *     samples.SendFromIsr(ReadAdc(), yield);
+ *     events.SetFromIsr(kAdcReady, yield);
+ * }   // yields here, once, if either call woke a higher-priority task
+ * @endcode
+ */
+
+#include "OsAbstraction.h"
+
+/**
+ * @class IsrYieldScope
+ * @brief Accumulates the woken flag of `*_from_isr` calls and yields once on
+ *        destruction.
+ */
+class IsrYieldScope {
+public:
+    IsrYieldScope() noexcept = default;
+    ~IsrYieldScope() { os_yield_from_isr(woken); }
+    IsrYieldScope(const IsrYieldScope&) = delete;
+    IsrYieldScope& operator=(const IsrYieldScope&) = delete;
+
+    /** Flag to hand to the `os_*_from_isr` calls. */
+    OS_IsrWoken* Flag() noexcept { return &woken; }
+
+    /** True if any call so far made a higher-priority task ready. */
+    bool Woken() const noexcept { return woken != 0; }
+
+private:
+    OS_IsrWoken woken{0};
+};
@@ -0,0 +1,138 @@
+#pragma once
+/**
+ * @file LatencyHistogram.h
+ * @brief Fixed-memory log-bucket histogram of microsecond latencies.
+ *
+ * Values are sorted into 4 linear sub-buckets per power of two, so any
+ * reported percentile is within 25 % of the true value across the full
+ * `uint32_t` microsecond range (0 µs .. ~71 min). `BaseThread` keeps two of
+ * these per thread when built with `HF_BASETHREAD_STEP_STATS`.
+ *
+ * Thread-safety: one writer (`Record`) and any number of concurrent readers
+ * (`Stats`, `Percentile`); all fields are relaxed atomics, so a reader may
+ * see a sample in the count but not yet in its bucket. `Reset` concurrent
+ * with `Record` may lose that sample.
+ *
+ * Allocation: none; 124 bucket counters plus count / sum / min / max inline
+ * (~520 bytes).
+ */
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Summary of a `LatencyHistogram`; all times in microseconds.
+ */
+struct LatencyStats {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t max_us;
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t p999_us;
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief Single-writer, lock-free-read latency histogram.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t kSubBucketBits = 2;
+    static constexpr uint32_t kSubBuckets    = 1U << kSubBucketBits;
+    static constexpr uint32_t kBucketCount   = (32U - kSubBucketBits + 1U) * kSubBuckets;
+
+    LatencyHistogram() noexcept { Reset(); }
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /** Add one sample of @p us microseconds. Writer only. */
+    void Record(uint32_t us) noexcept
+    {
+        auto& bucket = buckets_[BucketOf(us)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+        count_.store(count_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+        sum_.store(sum_.load(std::memory_order_relaxed) + us, std::memory_order_relaxed);
+        if (us < min_.load(std::memory_order_relaxed)) min_.store(us, std::memory_order_relaxed);
+        if (us > max_.load(std::memory_order_relaxed)) max_.store(us, std::memory_order_relaxed);
+    }
+
+    /** Drop every sample. */
+    void Reset() noexcept
+    {
+        for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        min_.store(UINT32_MAX, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    /** Number of samples recorded since the last Reset(). */
+    uint32_t Count() const noexcept { return count_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Value at or below which @p per_mille thousandths of the samples
+     *        fall (500 = median, 999 = p99.9).
+     * @return Upper edge of the bucket holding that sample, capped at the
+     *         maximum seen; 0 if empty.
+     */
+    uint32_t Percentile(uint32_t per_mille) const noexcept
+    {
+        uint64_t total = 0;
+        for (const auto& bucket : buckets_) total += bucket.load(std::memory_order_relaxed);
+        if (total == 0) return 0;
+
+        uint64_t rank = (total * per_mille + 999U) / 1000U;
+        if (rank == 0) rank = 1;
+
+        const uint32_t max = max_.load(std::memory_order_relaxed);
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < kBucketCount; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                const uint32_t upper = UpperEdgeOf(i);
+                return (upper < max) ? upper : max;
+            }
+        }
+        return max;
+    }
+
+    /** Snapshot count, min / avg / max and p50 / p99 / p99.9. */
+    LatencyStats Stats() const noexcept
+    {
+        LatencyStats s{};
+        s.count = count_.load(std::memory_order_relaxed);
+        if (s.count == 0) return s;
+        s.min_us  = min_.load(std::memory_order_relaxed);
+        s.max_us  = max_.load(std::memory_order_relaxed);
+        s.avg_us  = static_cast<uint32_t>(sum_.load(std::memory_order_relaxed) / s.count);
+        s.p50_us  = Percentile(500);
+        s.p99_us  = Percentile(990);
+        s.p999_us = Percentile(999);
+        return s;
+    }
+
+private:
+    static uint32_t BucketOf(uint32_t us) noexcept
+    {
+        if (us < kSubBuckets) return us;
+        const uint32_t msb = 31U - static_cast<uint32_t>(__builtin_clz(us));
+        const uint32_t sub = (us >> (msb - kSubBucketBits)) & (kSubBuckets - 1U);
+        return (msb - kSubBucketBits + 1U) * kSubBuckets + sub;
+    }
+
+    static uint32_t UpperEdgeOf(uint32_t bucket) noexcept
+    {
+        if (bucket < kSubBuckets) return bucket;
+        const uint32_t shift = bucket / kSubBuckets - 1U;
+        const uint32_t lower = (kSubBuckets + bucket % kSubBuckets) << shift;
+        return lower + ((1U << shift) - 1U);
+    }
+
+    std::atomic<uint32_t> buckets_[kBucketCount];
+    std::atomic<uint32_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint32_t> min_;
+    std::atomic<uint32_t> max_;
+};
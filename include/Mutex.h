@@ -9,8 +9,9 @@
  * Thread-safety: lock / unlock are safe from any task context (FreeRTOS
  * mutex). Not ISR-safe — use `RtosMutex` or a critical section for ISRs.
  *
- * Allocation: one RTOS mutex handle is allocated on construction; no
- * allocation in `Lock` / `Unlock`.
+ * Allocation: one RTOS mutex handle is allocated on first use; no
+ * allocation in `Lock` / `Unlock`. With `HF_RTOS_STATIC_ALLOCATION` the
+ * control block is a member of this object and the heap is never used.
  *
  * For `std::lock_guard` compatibility use `RtosMutex` (see `RtosMutex.h`);
  * this class is the named-handle variant intended for `BaseThread`
@@ -92,7 +93,11 @@ public:
     {
     	if ( !initialized )
     	{
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    		initialized = os_mutex_create_static_ex( mutex, mutexStorage, mutexName );
+#else
     		initialized = os_mutex_create_ex( mutex, mutexName );
+#endif
     	}
     	return initialized;
     }
@@ -102,6 +107,9 @@ public:
 private:
 
     OS_Mutex mutex;
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_MutexStorage mutexStorage;
+#endif
     char mutexName[MaxNameLength + 1];
     bool initialized;
 
@@ -7,6 +7,11 @@
  * generic types and helper functions.  None of the exported names expose the
  * specific RTOS being used so that a different implementation can be provided
  * in the future.
+ *
+ * Backends are selected at compile time:
+ *   - `HF_RTOS_FREERTOS` — FreeRTOS / ESP-IDF (target builds).
+ *   - `HF_RTOS_POSIX`    — pthreads on Linux hosts (src/OsAbstractionPosix.cpp).
+ *   - anything else      — single-threaded no-op stubs.
  */
 
 /* ── RTOS selection guard ────────────────────────────────────────────────── */
@@ -19,6 +24,9 @@
 #include "freertos/event_groups.h"
 #include "freertos/timers.h"
 #include "freertos/stream_buffer.h"
+#if defined(ESP_PLATFORM)
+#include "esp_timer.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,8 +56,31 @@ enum {
     OS_INHERIT      = 0
 };
 
+/** Thread states reported by os_thread_info_get(). */
+enum {
+    OS_THREAD_RUNNING   = eRunning,
+    OS_THREAD_READY     = eReady,
+    OS_THREAD_BLOCKED   = eBlocked,
+    OS_THREAD_SUSPENDED = eSuspended,
+    OS_THREAD_DELETED   = eDeleted
+};
+
 static inline OS_Ulong os_time_get(void) { return xTaskGetTickCount(); }
 
+/* Monotonic clock: 64-bit, never wraps in practice, independent of the tick
+ * rate. ESP-IDF reads the esp_timer counter (1 us resolution); other ports
+ * fall back to the tick count. */
+static inline uint64_t os_time_get_us(void)
+{
+#if defined(ESP_PLATFORM)
+    return (uint64_t)esp_timer_get_time();
+#else
+    return (uint64_t)xTaskGetTickCount() * (1000000ULL / configTICK_RATE_HZ);
+#endif
+}
+
+static inline uint64_t os_time_get_ns(void) { return os_time_get_us() * 1000ULL; }
+
 /* Thread wrappers ---------------------------------------------------------*/
 typedef struct {
     void (*entry)(OS_Ulong);
@@ -63,6 +94,13 @@ static inline void os_thread_start_trampoline(void *p)
     params.entry(params.arg);
 }
 
+/* Trampoline for caller-owned contexts: the context outlives the task. */
+static inline void os_thread_context_trampoline(void *p)
+{
+    const os_thread_start_t *params = (const os_thread_start_t *)p;
+    params->entry(params->arg);
+}
+
 static inline OS_Uint os_thread_create(OS_Thread *t, const char *name,
                                        void (*entry)(OS_Ulong),
                                        OS_Ulong input, uint8_t *stack,
@@ -123,6 +161,33 @@ static inline OS_Uint os_thread_create_pinned(OS_Thread *t, const char *name,
     return OS_SUCCESS;
 }
 
+/**
+ * @brief os_thread_create_pinned with a caller-owned start context.
+ *
+ * `ctx` is filled in here and must stay valid for the life of the task
+ * (e.g. a member of the owning object); no heap is used for it.
+ */
+static inline OS_Uint os_thread_create_ctx(OS_Thread *t, os_thread_start_t *ctx,
+                                           const char *name, void (*entry)(OS_Ulong),
+                                           OS_Ulong input, uint8_t * /*stack*/,
+                                           OS_Ulong stack_size, OS_Uint priority,
+                                           OS_Uint /*preempt*/, OS_Ulong /*slice*/,
+                                           OS_Uint auto_start, int core_id)
+{
+    if (!ctx) return 1;
+    ctx->entry = entry;
+    ctx->arg = input;
+    const BaseType_t affinity =
+        (core_id < 0) ? tskNO_AFFINITY : (BaseType_t)core_id;
+    BaseType_t res = xTaskCreatePinnedToCore(os_thread_context_trampoline, name,
+                                             stack_size / sizeof(StackType_t),
+                                             ctx, priority, t, affinity);
+    if (res != pdPASS) return 1;
+    if (!auto_start)
+        vTaskSuspend(*t);
+    return OS_SUCCESS;
+}
+
 /// Returns the FreeRTOS core ID the calling task is currently running on
 /// (0 or 1 on ESP32-S3). Returns 0 on single-core builds.
 static inline int os_get_current_core_id(void)
@@ -134,6 +199,16 @@ static inline int os_get_current_core_id(void)
 #endif
 }
 
+/// Returns the number of cores the scheduler runs tasks on (2 on ESP32-S3).
+static inline int os_get_core_count(void)
+{
+#if defined(portNUM_PROCESSORS)
+    return (int)portNUM_PROCESSORS;
+#else
+    return 1;
+#endif
+}
+
 static inline OS_Uint os_thread_resume(OS_Thread *t)   { vTaskResume(*t); return OS_SUCCESS; }
 static inline OS_Uint os_thread_suspend(OS_Thread *t)  { vTaskSuspend(*t); return OS_SUCCESS; }
 static inline OS_Uint os_thread_delete(OS_Thread *t)   { vTaskDelete(*t);  return OS_SUCCESS; }
@@ -145,6 +220,90 @@ static inline OS_Uint os_thread_info_get(OS_Thread *t, OS_Uint *state)
     return OS_SUCCESS;
 }
 static inline OS_Uint os_thread_sleep(OS_Ulong ticks)  { vTaskDelay(ticks); return OS_SUCCESS; }
+static inline OS_Ulong os_thread_stack_high_water_mark(const OS_Thread *t) { return uxTaskGetStackHighWaterMark(*t); }
+static inline OS_Uint os_thread_priority_set(OS_Thread *t, OS_Uint priority) { vTaskPrioritySet(*t, priority); return OS_SUCCESS; }
+/* Re-pin a created thread to core_id (< 0: no affinity). Needs a kernel with
+ * runtime affinity (configUSE_CORE_AFFINITY, e.g. ESP-IDF's CONFIG_FREERTOS_SMP);
+ * returns non-zero otherwise — choose the core at creation instead. */
+static inline OS_Uint os_thread_affinity_set(OS_Thread *t, int core_id)
+{
+#if (configUSE_CORE_AFFINITY == 1) && (configNUMBER_OF_CORES > 1)
+    if (core_id >= os_get_core_count()) return 1;
+    vTaskCoreAffinitySet(*t, (core_id < 0) ? tskNO_AFFINITY : (UBaseType_t)(1U << core_id));
+    return OS_SUCCESS;
+#else
+    (void)t; (void)core_id;
+    return 1;
+#endif
+}
+
+/* CPU time accounting ----------------------------------------------------*/
+/*
+ * Cumulative CPU time of a thread / of a core's idle task in microseconds,
+ * wrapping at 2^32 (take deltas). Backed by the kernel run-time stats, which
+ * count microseconds with ESP-IDF's default esp_timer clock source. Non-zero
+ * return when the kernel is built without configGENERATE_RUN_TIME_STATS.
+ */
+static inline OS_Uint os_thread_cpu_time_get(const OS_Thread *t, uint32_t *us)
+{
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    *us = (uint32_t)ulTaskGetRunTimeCounter(*t);
+    return OS_SUCCESS;
+#else
+    (void)t; *us = 0;
+    return 1;
+#endif
+}
+static inline OS_Uint os_core_idle_time_get(int core, uint32_t *us)
+{
+#if (configGENERATE_RUN_TIME_STATS == 1) && (INCLUDE_xTaskGetIdleTaskHandle == 1)
+    if (core < 0 || core >= os_get_core_count()) { *us = 0; return 1; }
+#if defined(ESP_PLATFORM) || (configNUMBER_OF_CORES > 1)
+    *us = (uint32_t)ulTaskGetRunTimeCounter(xTaskGetIdleTaskHandleForCore((BaseType_t)core));
+#else
+    *us = (uint32_t)ulTaskGetRunTimeCounter(xTaskGetIdleTaskHandle());
+#endif
+    return OS_SUCCESS;
+#else
+    (void)core; *us = 0;
+    return 1;
+#endif
+}
+
+/* Direct-to-task notification --------------------------------------------*/
+/*
+ * Counting notifications on one slot of each task's notification array.
+ * The last slot is used when the kernel provides more than one, keeping
+ * slot 0 free for stream buffers and application code; override with
+ * HF_RTOS_NOTIFY_INDEX.
+ *
+ * HF_RTOS_NOTIFY_DEDICATED is 1 when that slot is not slot 0, i.e. nothing
+ * outside this library notifies it. Library code that must not share the
+ * slot with application notifications checks it.
+ */
+#ifndef HF_RTOS_NOTIFY_INDEX
+#if defined(configTASK_NOTIFICATION_ARRAY_ENTRIES) && (configTASK_NOTIFICATION_ARRAY_ENTRIES > 1)
+#define HF_RTOS_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#else
+#define HF_RTOS_NOTIFY_INDEX 0
+#endif
+#endif
+#if HF_RTOS_NOTIFY_INDEX > 0
+#define HF_RTOS_NOTIFY_DEDICATED 1
+#else
+#define HF_RTOS_NOTIFY_DEDICATED 0
+#endif
+
+static inline OS_Thread os_thread_self(void) { return xTaskGetCurrentTaskHandle(); }
+/** Increment @p t's notification count, waking it if it is in os_thread_notify_take. */
+static inline OS_Uint os_thread_notify_give(OS_Thread *t)
+{ xTaskNotifyGiveIndexed(*t, HF_RTOS_NOTIFY_INDEX); return OS_SUCCESS; }
+/** Decrement the caller's notification count, blocking up to @p wait while it is zero. */
+static inline OS_Uint os_thread_notify_take(OS_Ulong wait)
+{ return ulTaskNotifyTakeIndexed(HF_RTOS_NOTIFY_INDEX, pdFALSE, wait) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+/** Current notification count of @p t, without consuming it. */
+static inline OS_Ulong os_thread_notify_peek(OS_Thread *t)
+{ return ulTaskNotifyValueClearIndexed(*t, HF_RTOS_NOTIFY_INDEX, 0); }
 
 /* Mutex wrappers ---------------------------------------------------------*/
 static inline OS_Uint os_mutex_create(OS_Mutex *m, const char * /*name*/, OS_Uint /*inherit*/)
@@ -189,10 +348,80 @@ static inline OS_Uint os_queue_create(OS_Queue *q, const char* /*name*/, OS_Uint
     *q = xQueueCreate(length, item_words * sizeof(uint32_t));
     return (*q) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1;
 }
+/**
+ * @brief Build a queue in place: `store` holds `length` items of
+ * `item_words` 32-bit words, `storage` the control block. No heap use;
+ * requires configSUPPORT_STATIC_ALLOCATION (always on in ESP-IDF).
+ */
+typedef StaticQueue_t OS_QueueStorage;
+static inline OS_Uint os_queue_create_static(OS_Queue *q, OS_QueueStorage *storage,
+                                             const char* /*name*/, OS_Uint item_words,
+                                             void *store, OS_Ulong length)
+{
+    if (!storage || !store) return 1;
+    *q = xQueueCreateStatic(length, item_words * sizeof(uint32_t),
+                            (uint8_t *)store, storage);
+    return (*q) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1;
+}
 static inline OS_Uint os_queue_delete(OS_Queue *q)    { vQueueDelete(*q); return OS_SUCCESS; }
-static inline OS_Uint os_queue_send(OS_Queue *q, void *msg, OS_Ulong wait)    { return xQueueSend(*q, msg, wait) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+static inline OS_Uint os_queue_send(OS_Queue *q, const void *msg, OS_Ulong wait) { return xQueueSend(*q, msg, wait) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
 static inline OS_Uint os_queue_receive(OS_Queue *q, void *msg, OS_Ulong wait) { return xQueueReceive(*q, msg, wait) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
 
+/*
+ * Batch transfer of contiguous items (stride = the queue's item size).
+ * FreeRTOS queues have no multi-item copy, so each batch moves every item it
+ * can without blocking while the scheduler is suspended: tasks it unblocks
+ * are switched to once per batch instead of once per item. Only the part of
+ * the batch that finds the queue full / empty blocks, one item at a time.
+ * Sends block until all `count` items are queued; receives block until
+ * `min_count` items arrived, then take up to `max_count`. Both report the
+ * number moved and succeed only if that target was met within `wait`.
+ */
+static inline OS_Uint os_queue_send_many(OS_Queue *q, const void *msgs, OS_Ulong count,
+                                         OS_Ulong *sent, OS_Ulong wait)
+{
+    const uint8_t *in = (const uint8_t *)msgs;
+    const UBaseType_t item = uxQueueGetQueueItemSize(*q);
+    TimeOut_t timeout;
+    TickType_t remaining = wait;
+    OS_Ulong n = 0;
+    vTaskSetTimeOutState(&timeout);
+    while (n < count) {
+        vTaskSuspendAll();
+        while (n < count && xQueueSend(*q, in + n * item, 0) == pdTRUE) ++n;
+        (void)xTaskResumeAll();
+        if (n == count || remaining == 0) break;
+        if (xQueueSend(*q, in + n * item, remaining) != pdTRUE) break;
+        ++n;
+        if (xTaskCheckForTimeOut(&timeout, &remaining) != pdFALSE) remaining = 0;
+    }
+    if (sent) *sent = n;
+    return (n == count) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1;
+}
+static inline OS_Uint os_queue_receive_many(OS_Queue *q, void *msgs, OS_Ulong max_count,
+                                            OS_Ulong min_count, OS_Ulong *received, OS_Ulong wait)
+{
+    uint8_t *out = (uint8_t *)msgs;
+    const UBaseType_t item = uxQueueGetQueueItemSize(*q);
+    TimeOut_t timeout;
+    TickType_t remaining = wait;
+    OS_Ulong n = 0;
+    if (min_count > max_count) min_count = max_count;
+    vTaskSetTimeOutState(&timeout);
+    while (n < min_count) {
+        if (xQueueReceive(*q, out + n * item, remaining) != pdTRUE) break;
+        ++n;
+        if (xTaskCheckForTimeOut(&timeout, &remaining) != pdFALSE) remaining = 0;
+    }
+    if (n < max_count) {
+        vTaskSuspendAll();
+        while (n < max_count && xQueueReceive(*q, out + n * item, 0) == pdTRUE) ++n;
+        (void)xTaskResumeAll();
+    }
+    if (received) *received = n;
+    return (n >= min_count) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1;
+}
+
 /* Event group wrappers ---------------------------------------------------*/
 static inline OS_Uint os_event_group_create(OS_EventGroup *g, const char* /*name*/)
 {
@@ -216,18 +445,18 @@ static inline OS_Uint os_event_group_get(OS_EventGroup *g, OS_Ulong flags, OS_Ui
 
 /* Timer wrappers ---------------------------------------------------------*/
 typedef struct {
-    void (*cb)(OS_Ulong);
+    void (*cb)(uint32_t);
     OS_Ulong id;
 } os_timer_cb_t;
 
 static inline void os_timer_trampoline(TimerHandle_t timer)
 {
     os_timer_cb_t *params = (os_timer_cb_t *)pvTimerGetTimerID(timer);
-    params->cb(params->id);
+    params->cb((uint32_t)params->id);
 }
 
 static inline OS_Uint os_timer_create(OS_Timer *t, const char *name,
-                                      void (*cb)(OS_Ulong), OS_Ulong id,
+                                      void (*cb)(uint32_t), OS_Ulong id,
                                       OS_Ulong initial, OS_Ulong reload,
                                       OS_Uint auto_act)
 {
@@ -246,12 +475,64 @@ static inline OS_Uint os_timer_create(OS_Timer *t, const char *name,
         xTimerStart(*t, 0);
     return OS_SUCCESS;
 }
+/**
+ * @brief os_timer_create with a caller-owned callback context.
+ *
+ * `ctx` must stay valid until os_timer_delete_ctx returns; no heap is used
+ * for it. Pair with os_timer_delete_ctx, never os_timer_delete.
+ */
+static inline OS_Uint os_timer_create_ctx(OS_Timer *t, os_timer_cb_t *ctx,
+                                          const char *name, void (*cb)(uint32_t),
+                                          OS_Ulong id, OS_Ulong initial,
+                                          OS_Ulong reload, OS_Uint auto_act)
+{
+    if (!ctx) return 1;
+    ctx->cb = cb;
+    ctx->id = id;
+    *t = xTimerCreate(name, initial, reload != 0, (void *)ctx,
+                      os_timer_trampoline);
+    if (!*t) return 1;
+    if (auto_act)
+        xTimerStart(*t, 0);
+    return OS_SUCCESS;
+}
+
+static inline void os_timer_flush_callback(void *done, uint32_t /*unused*/)
+{
+    xSemaphoreGive((SemaphoreHandle_t)done);
+}
+
+/**
+ * @brief Delete a timer and wait until the timer service has processed it.
+ *
+ * Timer commands are asynchronous: until the daemon dequeues the delete it
+ * may still fire the callback (reading the context) or touch the control
+ * block. A function call pended behind the delete marks the point after
+ * which neither can happen. Called from a timer callback (i.e. on the
+ * daemon itself) the wait is skipped; the callback's own context stays
+ * valid until it returns.
+ */
+static inline OS_Uint os_timer_delete_ctx(OS_Timer *t)
+{
+    if (xTimerDelete(*t, portMAX_DELAY) != pdPASS) return 1;
+    if (xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle())
+        return OS_SUCCESS;
+    StaticSemaphore_t done_storage;
+    SemaphoreHandle_t done = xSemaphoreCreateBinaryStatic(&done_storage);
+    if (xTimerPendFunctionCall(os_timer_flush_callback, (void *)done, 0,
+                               portMAX_DELAY) == pdPASS)
+        xSemaphoreTake(done, portMAX_DELAY);
+    vSemaphoreDelete(done);
+    return OS_SUCCESS;
+}
+
 static inline OS_Uint os_timer_delete(OS_Timer *t)
 {
     os_timer_cb_t *params = (os_timer_cb_t *)pvTimerGetTimerID(*t);
-    vPortFree(params);
-    xTimerDelete(*t, 0);
-    return OS_SUCCESS;
+    const OS_Uint status = os_timer_delete_ctx(t);
+    if (status == OS_SUCCESS)
+        vPortFree(params);
+    return status;
 }
 static inline OS_Uint os_timer_activate(OS_Timer *t)   { return xTimerStart(*t,0)==pdPASS ? OS_SUCCESS:(OS_Uint)1; }
 static inline OS_Uint os_timer_deactivate(OS_Timer *t) { return xTimerStop(*t,0)==pdPASS ? OS_SUCCESS:(OS_Uint)1; }
@@ -268,6 +549,136 @@ static inline OS_Uint os_stream_buffer_send(OS_StreamBuffer *b, const void *data
 static inline OS_Uint os_stream_buffer_receive(OS_StreamBuffer *b, void *data, size_t len, OS_Ulong wait)
 { return xStreamBufferReceive(*b, data, len, wait) > 0 ? OS_SUCCESS : (OS_Uint)1; }
 
+/* Static allocation ------------------------------------------------------*/
+/*
+ * With HF_RTOS_STATIC_ALLOCATION defined every control block lives in
+ * caller-provided storage (normally a member of the owning C++ wrapper) and
+ * the kernel heap is never touched. Storage must outlive the object.
+ */
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+
+#if !defined(configSUPPORT_STATIC_ALLOCATION) || (configSUPPORT_STATIC_ALLOCATION != 1)
+#error "HF_RTOS_STATIC_ALLOCATION requires configSUPPORT_STATIC_ALLOCATION = 1"
+#endif
+
+typedef StaticSemaphore_t       OS_MutexStorage;
+typedef StaticSemaphore_t       OS_SemaphoreStorage;
+typedef StaticEventGroup_t      OS_EventGroupStorage;
+typedef struct { StaticTimer_t timer; os_timer_cb_t cb; }       OS_TimerStorage;
+typedef struct { StaticTask_t tcb; os_thread_start_t start; }   OS_ThreadStorage;
+
+/**
+ * @brief Static variant of os_thread_create_pinned.
+ *
+ * `stack` is mandatory and becomes the task stack; `storage` holds the TCB
+ * and the entry trampoline context.
+ */
+static inline OS_Uint os_thread_create_static(OS_Thread *t, OS_ThreadStorage *storage,
+                                              const char *name, void (*entry)(OS_Ulong),
+                                              OS_Ulong input, uint8_t *stack,
+                                              OS_Ulong stack_size, OS_Uint priority,
+                                              OS_Uint /*preempt*/, OS_Ulong /*slice*/,
+                                              OS_Uint auto_start, int core_id)
+{
+    if (!storage || !stack) return 1;
+    storage->start.entry = entry;
+    storage->start.arg = input;
+    const BaseType_t affinity =
+        (core_id < 0) ? tskNO_AFFINITY : (BaseType_t)core_id;
+    *t = xTaskCreateStaticPinnedToCore(os_thread_context_trampoline, name,
+                                       stack_size / sizeof(StackType_t),
+                                       &storage->start, priority,
+                                       (StackType_t *)stack, &storage->tcb,
+                                       affinity);
+    if (!*t) return 1;
+    if (!auto_start)
+        vTaskSuspend(*t);
+    return OS_SUCCESS;
+}
+
+static inline OS_Uint os_mutex_create_static(OS_Mutex *m, OS_MutexStorage *storage,
+                                             const char * /*name*/, OS_Uint /*inherit*/)
+{
+    *m = xSemaphoreCreateMutexStatic(storage);
+    return (*m) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1;
+}
+static inline OS_Uint os_recursive_mutex_create_static(OS_Mutex *m, OS_MutexStorage *storage,
+                                                       const char * /*name*/)
+{
+    *m = xSemaphoreCreateRecursiveMutexStatic(storage);
+    return (*m) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1;
+}
+static inline OS_Uint os_semaphore_create_static(OS_Semaphore *s, OS_SemaphoreStorage *storage,
+                                                 const char * /*name*/, OS_Uint initial)
+{
+    *s = xSemaphoreCreateCountingStatic(UINT16_MAX, initial, storage);
+    return (*s) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1;
+}
+static inline OS_Uint os_event_group_create_static(OS_EventGroup *g, OS_EventGroupStorage *storage,
+                                                   const char * /*name*/)
+{
+    *g = xEventGroupCreateStatic(storage);
+    return (*g) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1;
+}
+static inline OS_Uint os_timer_create_static(OS_Timer *t, OS_TimerStorage *storage,
+                                             const char *name, void (*cb)(uint32_t),
+                                             OS_Ulong id, OS_Ulong initial,
+                                             OS_Ulong reload, OS_Uint auto_act)
+{
+    storage->cb.cb = cb;
+    storage->cb.id = id;
+    *t = xTimerCreateStatic(name, initial, reload != 0, (void *)&storage->cb,
+                            os_timer_trampoline, &storage->timer);
+    if (!*t) return 1;
+    if (auto_act)
+        xTimerStart(*t, 0);
+    return OS_SUCCESS;
+}
+
+/**
+ * @brief Delete a timer created by os_timer_create_static.
+ *
+ * Returns once the timer service no longer references the storage (see
+ * os_timer_delete_ctx).
+ */
+static inline OS_Uint os_timer_delete_static(OS_Timer *t) { return os_timer_delete_ctx(t); }
+
+#endif /* HF_RTOS_STATIC_ALLOCATION */
+
+/* ISR-safe variants ------------------------------------------------------*/
+/*
+ * Interrupt context only; none of these block. Each sets *woken when the
+ * call made a higher-priority task ready (it never clears it), so one flag
+ * can collect a whole handler's worth of calls and be passed to a single
+ * os_yield_from_isr at the end (see hf::IsrYieldScope).
+ */
+typedef BaseType_t OS_IsrWoken;
+
+static inline int  os_in_isr(void)                      { return xPortInIsrContext() ? 1 : 0; }
+static inline void os_yield_from_isr(OS_IsrWoken woken) { portYIELD_FROM_ISR(woken); }
+
+static inline OS_Uint os_thread_notify_give_from_isr(OS_Thread *t, OS_IsrWoken *woken)
+{ vTaskNotifyGiveIndexedFromISR(*t, HF_RTOS_NOTIFY_INDEX, woken); return OS_SUCCESS; }
+static inline OS_Uint os_semaphore_put_from_isr(OS_Semaphore *s, OS_IsrWoken *woken)
+{ return xSemaphoreGiveFromISR(*s, woken) == pdTRUE ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+static inline OS_Uint os_semaphore_get_from_isr(OS_Semaphore *s, OS_IsrWoken *woken)
+{ return xSemaphoreTakeFromISR(*s, woken) == pdTRUE ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+static inline OS_Uint os_queue_send_from_isr(OS_Queue *q, const void *msg, OS_IsrWoken *woken)
+{ return xQueueSendFromISR(*q, msg, woken) == pdTRUE ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+static inline OS_Uint os_queue_receive_from_isr(OS_Queue *q, void *msg, OS_IsrWoken *woken)
+{ return xQueueReceiveFromISR(*q, msg, woken) == pdTRUE ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+/* Deferred to the timer service task; fails if its command queue is full. */
+static inline OS_Uint os_event_group_set_from_isr(OS_EventGroup *g, OS_Ulong flags, OS_IsrWoken *woken)
+{ return xEventGroupSetBitsFromISR(*g, flags, woken) == pdPASS ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+static inline OS_Uint os_timer_activate_from_isr(OS_Timer *t, OS_IsrWoken *woken)
+{ return xTimerStartFromISR(*t, woken) == pdPASS ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+static inline OS_Uint os_timer_deactivate_from_isr(OS_Timer *t, OS_IsrWoken *woken)
+{ return xTimerStopFromISR(*t, woken) == pdPASS ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+static inline OS_Uint os_stream_buffer_send_from_isr(OS_StreamBuffer *b, const void *data, size_t len, OS_IsrWoken *woken)
+{ return xStreamBufferSendFromISR(*b, data, len, woken) == len ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+static inline OS_Uint os_stream_buffer_receive_from_isr(OS_StreamBuffer *b, void *data, size_t len, OS_IsrWoken *woken)
+{ return xStreamBufferReceiveFromISR(*b, data, len, woken) > 0 ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
+
 /* Critical section wrappers ----------------------------------------------*/
 typedef portMUX_TYPE OS_Critical;
 extern OS_Critical os_critical_mux;
@@ -278,6 +689,330 @@ static inline void os_critical_exit(void)   { portEXIT_CRITICAL(&os_critical_mux
 }
 #endif
 
+#elif defined(HF_RTOS_POSIX)
+
+/*
+ * POSIX host backend — every primitive is implemented on pthreads, condition
+ * variables and CLOCK_MONOTONIC in src/OsAbstractionPosix.cpp so the C++
+ * wrappers run with real concurrency on Linux build hosts.
+ *
+ * One tick is one millisecond. Thread suspension and deletion are
+ * cooperative: they take effect the next time the target thread enters a
+ * blocking os_* call (immediately when a thread targets itself).
+ * os_thread_delete waits up to HF_RTOS_POSIX_DELETE_WAIT_MS for that to
+ * happen; if the thread is still busy outside os_* calls by then it returns
+ * 1, the thread parks at its next os_* call, and anything it still touches
+ * must outlive it. Priorities are recorded but not applied; core affinity
+ * is applied on Linux for cores below os_get_core_count() and ignored
+ * beyond it.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef HF_RTOS_POSIX_DELETE_WAIT_MS
+#define HF_RTOS_POSIX_DELETE_WAIT_MS 2000
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef unsigned long           OS_Ulong;
+typedef unsigned int            OS_Uint;
+
+/** Control blocks. Handles are pointers to these. */
+typedef struct os_posix_thread {
+    pthread_t        tid;
+    pthread_mutex_t  lock;
+    pthread_cond_t   cond;
+    void           (*entry)(OS_Ulong);
+    OS_Ulong         arg;
+    pthread_cond_t  *wait_cond;     /* object the thread is blocked on, if any */
+    pthread_mutex_t *wait_mutex;
+    OS_Ulong         stack_size;
+    OS_Uint          priority;
+    int              core_id;
+    int              suspended;
+    int              delete_requested;
+    int              parked;
+    int              exited;
+    OS_Ulong         notify_count;  /* direct-to-task notification counter */
+    char             name[16];
+} os_posix_thread_t;
+
+typedef struct os_posix_mutex {
+    pthread_mutex_t  lock;
+    pthread_cond_t   cond;
+    pthread_t        owner;
+    OS_Uint          count;
+    int              recursive;
+    int              static_storage;  /* caller-owned, never freed */
+} os_posix_mutex_t;
+
+typedef struct os_posix_semaphore {
+    pthread_mutex_t  lock;
+    pthread_cond_t   cond;
+    OS_Ulong         count;
+    OS_Ulong         max_count;
+    int              static_storage;
+} os_posix_semaphore_t;
+
+typedef struct os_posix_queue {
+    pthread_mutex_t  lock;
+    pthread_cond_t   not_empty;
+    pthread_cond_t   not_full;
+    uint8_t         *buffer;
+    size_t           item_size;
+    OS_Ulong         length;
+    OS_Ulong         head;
+    OS_Ulong         count;
+    int              static_storage;  /* block and buffer are caller-owned */
+} os_posix_queue_t;
+
+typedef struct os_posix_event_group {
+    pthread_mutex_t  lock;
+    pthread_cond_t   cond;
+    OS_Ulong         bits;
+    int              static_storage;
+} os_posix_event_group_t;
+
+typedef struct os_posix_timer {
+    struct os_posix_timer *next;
+    void           (*cb)(uint32_t);
+    OS_Ulong         id;
+    OS_Ulong         period;
+    uint64_t         expiry_ns;
+    int              auto_reload;
+    int              linked;
+    int              static_storage;
+} os_posix_timer_t;
+
+typedef struct os_posix_stream_buffer {
+    pthread_mutex_t  lock;
+    pthread_cond_t   cond;
+    uint8_t         *buffer;
+    size_t           capacity;
+    size_t           trigger;
+    size_t           head;
+    size_t           count;
+} os_posix_stream_buffer_t;
+
+typedef os_posix_thread_t*        OS_Thread;
+typedef os_posix_mutex_t*         OS_Mutex;
+typedef os_posix_semaphore_t*     OS_Semaphore;
+typedef os_posix_queue_t*         OS_Queue;
+typedef os_posix_event_group_t*   OS_EventGroup;
+typedef os_posix_timer_t*         OS_Timer;
+typedef os_posix_stream_buffer_t* OS_StreamBuffer;
+
+enum {
+    OS_WAIT_FOREVER = 0xFFFFFFFFUL,
+    OS_NO_WAIT      = 0,
+    OS_SUCCESS      = 0,
+    OS_AND          = 1,
+    OS_OR           = 2,
+    OS_AUTO_START   = 1,
+    OS_DONT_START   = 0,
+    OS_INHERIT      = 0
+};
+
+enum {
+    OS_THREAD_RUNNING   = 0,
+    OS_THREAD_READY     = 1,
+    OS_THREAD_BLOCKED   = 2,
+    OS_THREAD_SUSPENDED = 3,
+    OS_THREAD_DELETED   = 4
+};
+
+OS_Ulong os_time_get(void);
+
+/* Monotonic clock (CLOCK_MONOTONIC), zeroed at first use like os_time_get. */
+uint64_t os_time_get_us(void);
+uint64_t os_time_get_ns(void);
+
+/* Thread wrappers ---------------------------------------------------------*/
+typedef struct { void (*entry)(OS_Ulong); OS_Ulong arg; } os_thread_start_t;
+
+OS_Uint os_thread_create(OS_Thread *t, const char *name, void (*entry)(OS_Ulong),
+                         OS_Ulong input, uint8_t *stack, OS_Ulong stack_size,
+                         OS_Uint priority, OS_Uint preempt, OS_Ulong slice,
+                         OS_Uint auto_start);
+OS_Uint os_thread_create_pinned(OS_Thread *t, const char *name, void (*entry)(OS_Ulong),
+                                OS_Ulong input, uint8_t *stack, OS_Ulong stack_size,
+                                OS_Uint priority, OS_Uint preempt, OS_Ulong slice,
+                                OS_Uint auto_start, int core_id);
+OS_Uint os_thread_create_ctx(OS_Thread *t, os_thread_start_t *ctx, const char *name,
+                             void (*entry)(OS_Ulong), OS_Ulong input, uint8_t *stack,
+                             OS_Ulong stack_size, OS_Uint priority, OS_Uint preempt,
+                             OS_Ulong slice, OS_Uint auto_start, int core_id);
+int     os_get_current_core_id(void);
+int     os_get_core_count(void);
+OS_Uint os_thread_resume(OS_Thread *t);
+OS_Uint os_thread_suspend(OS_Thread *t);
+OS_Uint os_thread_delete(OS_Thread *t);
+OS_Uint os_thread_terminate(OS_Thread *t);
+OS_Uint os_thread_info_get(OS_Thread *t, OS_Uint *state);
+OS_Uint os_thread_sleep(OS_Ulong ticks);
+OS_Ulong os_thread_stack_high_water_mark(const OS_Thread *t);
+OS_Uint os_thread_priority_set(OS_Thread *t, OS_Uint priority);
+/* Re-pin a created thread to core_id (< 0: no affinity); applied on Linux. */
+OS_Uint os_thread_affinity_set(OS_Thread *t, int core_id);
+
+/* CPU time accounting ----------------------------------------------------*/
+/* Per-thread CPU clock (pthread_getcpuclockid) in microseconds, wrapping at
+ * 2^32. Per-core idle time is not measured on hosts: always non-zero. */
+OS_Uint os_thread_cpu_time_get(const OS_Thread *t, uint32_t *us);
+OS_Uint os_core_idle_time_get(int core, uint32_t *us);
+
+/* Direct-to-task notification (per-thread counter + condvar) -------------*/
+/* os_thread_self() is NULL on threads not created through os_thread_create.
+ * The counter has no other users (stream buffers do not use it), so it
+ * counts as a dedicated slot. */
+#define HF_RTOS_NOTIFY_DEDICATED 1
+OS_Thread os_thread_self(void);
+OS_Uint   os_thread_notify_give(OS_Thread *t);
+OS_Uint   os_thread_notify_take(OS_Ulong wait);
+OS_Ulong  os_thread_notify_peek(OS_Thread *t);
+
+/* Mutex wrappers ---------------------------------------------------------*/
+OS_Uint os_mutex_create(OS_Mutex *m, const char *name, OS_Uint inherit);
+OS_Uint os_mutex_get(OS_Mutex *m, OS_Ulong wait);
+OS_Uint os_mutex_put(OS_Mutex *m);
+OS_Uint os_mutex_delete(OS_Mutex *m);
+
+/* Recursive Mutex wrappers -----------------------------------------------*/
+OS_Uint os_recursive_mutex_create(OS_Mutex *m, const char *name);
+OS_Uint os_recursive_mutex_get(OS_Mutex *m, OS_Ulong wait);
+OS_Uint os_recursive_mutex_put(OS_Mutex *m);
+OS_Uint os_recursive_mutex_delete(OS_Mutex *m);
+
+/* Semaphore wrappers -----------------------------------------------------*/
+OS_Uint os_semaphore_create(OS_Semaphore *s, const char *name, OS_Uint initial);
+OS_Uint os_semaphore_delete(OS_Semaphore *s);
+OS_Uint os_semaphore_put(OS_Semaphore *s);
+OS_Uint os_semaphore_get(OS_Semaphore *s, OS_Ulong wait);
+OS_Uint os_semaphore_info_get(OS_Semaphore *s, OS_Ulong *count);
+
+/* Queue wrappers ---------------------------------------------------------*/
+OS_Uint os_queue_create(OS_Queue *q, const char *name, OS_Uint item_words,
+                        void *store, OS_Ulong length);
+typedef os_posix_queue_t OS_QueueStorage;
+OS_Uint os_queue_create_static(OS_Queue *q, OS_QueueStorage *storage, const char *name,
+                               OS_Uint item_words, void *store, OS_Ulong length);
+OS_Uint os_queue_delete(OS_Queue *q);
+OS_Uint os_queue_send(OS_Queue *q, const void *msg, OS_Ulong wait);
+OS_Uint os_queue_receive(OS_Queue *q, void *msg, OS_Ulong wait);
+/* Batch transfer under one lock round-trip per wakeup; see the FreeRTOS section. */
+OS_Uint os_queue_send_many(OS_Queue *q, const void *msgs, OS_Ulong count,
+                           OS_Ulong *sent, OS_Ulong wait);
+OS_Uint os_queue_receive_many(OS_Queue *q, void *msgs, OS_Ulong max_count,
+                              OS_Ulong min_count, OS_Ulong *received, OS_Ulong wait);
+
+/* Event group wrappers ---------------------------------------------------*/
+OS_Uint os_event_group_create(OS_EventGroup *g, const char *name);
+OS_Uint os_event_group_delete(OS_EventGroup *g);
+OS_Uint os_event_group_set(OS_EventGroup *g, OS_Ulong flags);
+OS_Uint os_event_group_clear(OS_EventGroup *g, OS_Ulong flags);
+OS_Uint os_event_group_get(OS_EventGroup *g, OS_Ulong flags, OS_Uint option,
+                           OS_Ulong *actual, OS_Ulong wait);
+
+/* Timer wrappers (serviced by a single daemon thread) --------------------*/
+typedef struct { void (*cb)(uint32_t); OS_Ulong id; } os_timer_cb_t;
+
+OS_Uint os_timer_create(OS_Timer *t, const char *name, void (*cb)(uint32_t),
+                        OS_Ulong id, OS_Ulong initial, OS_Ulong reload,
+                        OS_Uint auto_act);
+OS_Uint os_timer_create_ctx(OS_Timer *t, os_timer_cb_t *ctx, const char *name,
+                            void (*cb)(uint32_t), OS_Ulong id, OS_Ulong initial,
+                            OS_Ulong reload, OS_Uint auto_act);
+OS_Uint os_timer_delete(OS_Timer *t);
+OS_Uint os_timer_delete_ctx(OS_Timer *t);
+OS_Uint os_timer_activate(OS_Timer *t);
+OS_Uint os_timer_deactivate(OS_Timer *t);
+
+/* Stream buffer wrappers ------------------------------------------------*/
+OS_Uint os_stream_buffer_create(OS_StreamBuffer *b, size_t capacity, size_t trigger);
+OS_Uint os_stream_buffer_delete(OS_StreamBuffer *b);
+OS_Uint os_stream_buffer_send(OS_StreamBuffer *b, const void *data, size_t len, OS_Ulong wait);
+OS_Uint os_stream_buffer_receive(OS_StreamBuffer *b, void *data, size_t len, OS_Ulong wait);
+
+/* Static allocation ------------------------------------------------------*/
+/*
+ * Mutex, semaphore, event group and timer control blocks are initialised in
+ * the caller's storage. Thread control blocks stay on the heap even in this
+ * mode: a deleted thread parks on its own block and must not outlive it.
+ */
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+
+typedef os_posix_mutex_t        OS_MutexStorage;
+typedef os_posix_semaphore_t    OS_SemaphoreStorage;
+typedef os_posix_event_group_t  OS_EventGroupStorage;
+typedef os_posix_timer_t        OS_TimerStorage;
+typedef struct { int unused; }  OS_ThreadStorage;
+
+OS_Uint os_thread_create_static(OS_Thread *t, OS_ThreadStorage *storage,
+                                const char *name, void (*entry)(OS_Ulong),
+                                OS_Ulong input, uint8_t *stack, OS_Ulong stack_size,
+                                OS_Uint priority, OS_Uint preempt, OS_Ulong slice,
+                                OS_Uint auto_start, int core_id);
+OS_Uint os_mutex_create_static(OS_Mutex *m, OS_MutexStorage *storage,
+                               const char *name, OS_Uint inherit);
+OS_Uint os_recursive_mutex_create_static(OS_Mutex *m, OS_MutexStorage *storage,
+                                         const char *name);
+OS_Uint os_semaphore_create_static(OS_Semaphore *s, OS_SemaphoreStorage *storage,
+                                   const char *name, OS_Uint initial);
+OS_Uint os_event_group_create_static(OS_EventGroup *g, OS_EventGroupStorage *storage,
+                                     const char *name);
+OS_Uint os_timer_create_static(OS_Timer *t, OS_TimerStorage *storage, const char *name,
+                               void (*cb)(uint32_t), OS_Ulong id, OS_Ulong initial,
+                               OS_Ulong reload, OS_Uint auto_act);
+OS_Uint os_timer_delete_static(OS_Timer *t);
+
+#endif /* HF_RTOS_STATIC_ALLOCATION */
+
+/* ISR-safe variants ------------------------------------------------------*/
+/*
+ * There are no interrupts on the host: these are the non-blocking forms of
+ * the regular calls, so ISR code paths can be driven from a thread in host
+ * tests. *woken is left untouched.
+ */
+typedef int OS_IsrWoken;
+
+static inline int  os_in_isr(void)                      { return 0; }
+static inline void os_yield_from_isr(OS_IsrWoken woken) { (void)woken; }
+
+static inline OS_Uint os_thread_notify_give_from_isr(OS_Thread *t, OS_IsrWoken *woken)
+{ (void)woken; return os_thread_notify_give(t); }
+static inline OS_Uint os_semaphore_put_from_isr(OS_Semaphore *s, OS_IsrWoken *woken)
+{ (void)woken; return os_semaphore_put(s); }
+static inline OS_Uint os_semaphore_get_from_isr(OS_Semaphore *s, OS_IsrWoken *woken)
+{ (void)woken; return os_semaphore_get(s, OS_NO_WAIT); }
+static inline OS_Uint os_queue_send_from_isr(OS_Queue *q, const void *msg, OS_IsrWoken *woken)
+{ (void)woken; return os_queue_send(q, msg, OS_NO_WAIT); }
+static inline OS_Uint os_queue_receive_from_isr(OS_Queue *q, void *msg, OS_IsrWoken *woken)
+{ (void)woken; return os_queue_receive(q, msg, OS_NO_WAIT); }
+static inline OS_Uint os_event_group_set_from_isr(OS_EventGroup *g, OS_Ulong flags, OS_IsrWoken *woken)
+{ (void)woken; return os_event_group_set(g, flags); }
+static inline OS_Uint os_timer_activate_from_isr(OS_Timer *t, OS_IsrWoken *woken)
+{ (void)woken; return os_timer_activate(t); }
+static inline OS_Uint os_timer_deactivate_from_isr(OS_Timer *t, OS_IsrWoken *woken)
+{ (void)woken; return os_timer_deactivate(t); }
+static inline OS_Uint os_stream_buffer_send_from_isr(OS_StreamBuffer *b, const void *data, size_t len, OS_IsrWoken *woken)
+{ (void)woken; return os_stream_buffer_send(b, data, len, OS_NO_WAIT); }
+static inline OS_Uint os_stream_buffer_receive_from_isr(OS_StreamBuffer *b, void *data, size_t len, OS_IsrWoken *woken)
+{ (void)woken; return os_stream_buffer_receive(b, data, len, OS_NO_WAIT); }
+
+/* Critical section wrappers (process-wide recursive mutex) ---------------*/
+typedef pthread_mutex_t OS_Critical;
+void os_critical_enter(void);
+void os_critical_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
 #else /* HF_RTOS_NONE (or no RTOS selected) — bare-metal / host-only stubs */
 
 #include <stdint.h>
@@ -310,7 +1045,17 @@ enum {
     OS_INHERIT      = 0
 };
 
+enum {
+    OS_THREAD_RUNNING   = 0,
+    OS_THREAD_READY     = 1,
+    OS_THREAD_BLOCKED   = 2,
+    OS_THREAD_SUSPENDED = 3,
+    OS_THREAD_DELETED   = 4
+};
+
 static inline OS_Ulong os_time_get(void) { return 0; }
+static inline uint64_t os_time_get_us(void) { return 0; }
+static inline uint64_t os_time_get_ns(void) { return 0; }
 
 /* Thread — no-ops (single-threaded) */
 typedef struct { void (*entry)(OS_Ulong); OS_Ulong arg; } os_thread_start_t;
@@ -333,7 +1078,17 @@ static inline OS_Uint os_thread_create_pinned(OS_Thread *t, const char *name,
 { (void)core_id;
   return os_thread_create(t, name, entry, input, stack, stack_size,
                           priority, preempt, slice, auto_start); }
+static inline OS_Uint os_thread_create_ctx(OS_Thread *t, os_thread_start_t *ctx,
+                                           const char *name, void (*entry)(OS_Ulong),
+                                           OS_Ulong input, uint8_t *stack,
+                                           OS_Ulong stack_size, OS_Uint priority,
+                                           OS_Uint preempt, OS_Ulong slice,
+                                           OS_Uint auto_start, int core_id)
+{ (void)ctx; (void)core_id;
+  return os_thread_create(t, name, entry, input, stack, stack_size,
+                          priority, preempt, slice, auto_start); }
 static inline int os_get_current_core_id(void) { return 0; }
+static inline int os_get_core_count(void) { return 1; }
 static inline OS_Uint os_thread_resume(OS_Thread *t)    { (void)t; return OS_SUCCESS; }
 static inline OS_Uint os_thread_suspend(OS_Thread *t)   { (void)t; return OS_SUCCESS; }
 static inline OS_Uint os_thread_delete(OS_Thread *t)    { (void)t; return OS_SUCCESS; }
@@ -341,6 +1096,16 @@ static inline OS_Uint os_thread_terminate(OS_Thread *t) { (void)t; return OS_SUC
 static inline OS_Uint os_thread_info_get(OS_Thread *t, OS_Uint *state)
 { (void)t; if (state) *state = 0; return OS_SUCCESS; }
 static inline OS_Uint os_thread_sleep(OS_Ulong ticks)   { (void)ticks; return OS_SUCCESS; }
+static inline OS_Ulong os_thread_stack_high_water_mark(const OS_Thread *t) { (void)t; return 0; }
+static inline OS_Uint os_thread_priority_set(OS_Thread *t, OS_Uint priority) { (void)t; (void)priority; return OS_SUCCESS; }
+static inline OS_Uint os_thread_affinity_set(OS_Thread *t, int core_id) { (void)t; return (core_id <= 0) ? OS_SUCCESS : (OS_Uint)1; }
+static inline OS_Uint os_thread_cpu_time_get(const OS_Thread *t, uint32_t *us) { (void)t; *us = 0; return 1; }
+static inline OS_Uint os_core_idle_time_get(int core, uint32_t *us) { (void)core; *us = 0; return 1; }
+#define HF_RTOS_NOTIFY_DEDICATED 0
+static inline OS_Thread os_thread_self(void) { return NULL; }
+static inline OS_Uint os_thread_notify_give(OS_Thread *t) { (void)t; return OS_SUCCESS; }
+static inline OS_Uint os_thread_notify_take(OS_Ulong wait) { (void)wait; return (OS_Uint)1; }
+static inline OS_Ulong os_thread_notify_peek(OS_Thread *t) { (void)t; return 0; }
 
 /* Mutex — always succeeds (single-threaded, no contention) */
 static inline OS_Uint os_mutex_create(OS_Mutex *m, const char *name, OS_Uint inherit)
@@ -369,11 +1134,21 @@ static inline OS_Uint os_semaphore_info_get(OS_Semaphore *s, OS_Ulong *count)
 static inline OS_Uint os_queue_create(OS_Queue *q, const char *name, OS_Uint item_words,
                                       void *store, OS_Ulong length)
 { (void)q; (void)name; (void)item_words; (void)store; (void)length; return OS_SUCCESS; }
+typedef struct { int unused; } OS_QueueStorage;
+static inline OS_Uint os_queue_create_static(OS_Queue *q, OS_QueueStorage *storage, const char *name,
+                                             OS_Uint item_words, void *store, OS_Ulong length)
+{ (void)storage; return os_queue_create(q, name, item_words, store, length); }
 static inline OS_Uint os_queue_delete(OS_Queue *q)    { (void)q; return OS_SUCCESS; }
-static inline OS_Uint os_queue_send(OS_Queue *q, void *msg, OS_Ulong wait)
+static inline OS_Uint os_queue_send(OS_Queue *q, const void *msg, OS_Ulong wait)
 { (void)q; (void)msg; (void)wait; return OS_SUCCESS; }
 static inline OS_Uint os_queue_receive(OS_Queue *q, void *msg, OS_Ulong wait)
 { (void)q; (void)msg; (void)wait; return (OS_Uint)1; /* nothing to receive */ }
+static inline OS_Uint os_queue_send_many(OS_Queue *q, const void *msgs, OS_Ulong count,
+                                         OS_Ulong *sent, OS_Ulong wait)
+{ (void)q; (void)msgs; (void)wait; if (sent) *sent = count; return OS_SUCCESS; }
+static inline OS_Uint os_queue_receive_many(OS_Queue *q, void *msgs, OS_Ulong max_count,
+                                            OS_Ulong min_count, OS_Ulong *received, OS_Ulong wait)
+{ (void)q; (void)msgs; (void)max_count; (void)wait; if (received) *received = 0; return (min_count == 0U) ? (OS_Uint)OS_SUCCESS : (OS_Uint)1; }
 
 /* Event group — always succeeds */
 static inline OS_Uint os_event_group_create(OS_EventGroup *g, const char *name)
@@ -388,14 +1163,20 @@ static inline OS_Uint os_event_group_get(OS_EventGroup *g, OS_Ulong flags, OS_Ui
 { (void)g; (void)flags; (void)option; (void)wait; if (actual) *actual = 0; return OS_SUCCESS; }
 
 /* Timer — no-ops (no scheduler) */
-typedef struct { void (*cb)(OS_Ulong); OS_Ulong id; } os_timer_cb_t;
+typedef struct { void (*cb)(uint32_t); OS_Ulong id; } os_timer_cb_t;
 static inline OS_Uint os_timer_create(OS_Timer *t, const char *name,
-                                      void (*cb)(OS_Ulong), OS_Ulong id,
+                                      void (*cb)(uint32_t), OS_Ulong id,
                                       OS_Ulong initial, OS_Ulong reload,
                                       OS_Uint auto_act)
 { (void)t; (void)name; (void)cb; (void)id; (void)initial; (void)reload;
   (void)auto_act; return OS_SUCCESS; }
+static inline OS_Uint os_timer_create_ctx(OS_Timer *t, os_timer_cb_t *ctx,
+                                          const char *name, void (*cb)(uint32_t),
+                                          OS_Ulong id, OS_Ulong initial,
+                                          OS_Ulong reload, OS_Uint auto_act)
+{ (void)ctx; return os_timer_create(t, name, cb, id, initial, reload, auto_act); }
 static inline OS_Uint os_timer_delete(OS_Timer *t)     { (void)t; return OS_SUCCESS; }
+static inline OS_Uint os_timer_delete_ctx(OS_Timer *t) { (void)t; return OS_SUCCESS; }
 static inline OS_Uint os_timer_activate(OS_Timer *t)   { (void)t; return OS_SUCCESS; }
 static inline OS_Uint os_timer_deactivate(OS_Timer *t) { (void)t; return OS_SUCCESS; }
 
@@ -408,6 +1189,69 @@ static inline OS_Uint os_stream_buffer_send(OS_StreamBuffer *b, const void *data
 static inline OS_Uint os_stream_buffer_receive(OS_StreamBuffer *b, void *data, size_t len, OS_Ulong wait)
 { (void)b; (void)data; (void)len; (void)wait; return (OS_Uint)1; }
 
+/* Static allocation — no-ops (storage is never touched) */
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+typedef struct { int unused; } OS_MutexStorage;
+typedef struct { int unused; } OS_SemaphoreStorage;
+typedef struct { int unused; } OS_EventGroupStorage;
+typedef struct { int unused; } OS_TimerStorage;
+typedef struct { int unused; } OS_ThreadStorage;
+static inline OS_Uint os_thread_create_static(OS_Thread *t, OS_ThreadStorage *storage,
+                                              const char *name, void (*entry)(OS_Ulong),
+                                              OS_Ulong input, uint8_t *stack,
+                                              OS_Ulong stack_size, OS_Uint priority,
+                                              OS_Uint preempt, OS_Ulong slice,
+                                              OS_Uint auto_start, int core_id)
+{ (void)storage; (void)core_id;
+  return os_thread_create(t, name, entry, input, stack, stack_size,
+                          priority, preempt, slice, auto_start); }
+static inline OS_Uint os_mutex_create_static(OS_Mutex *m, OS_MutexStorage *storage,
+                                             const char *name, OS_Uint inherit)
+{ (void)storage; return os_mutex_create(m, name, inherit); }
+static inline OS_Uint os_recursive_mutex_create_static(OS_Mutex *m, OS_MutexStorage *storage,
+                                                       const char *name)
+{ (void)storage; return os_recursive_mutex_create(m, name); }
+static inline OS_Uint os_semaphore_create_static(OS_Semaphore *s, OS_SemaphoreStorage *storage,
+                                                 const char *name, OS_Uint initial)
+{ (void)storage; return os_semaphore_create(s, name, initial); }
+static inline OS_Uint os_event_group_create_static(OS_EventGroup *g, OS_EventGroupStorage *storage,
+                                                   const char *name)
+{ (void)storage; return os_event_group_create(g, name); }
+static inline OS_Uint os_timer_create_static(OS_Timer *t, OS_TimerStorage *storage,
+                                             const char *name, void (*cb)(uint32_t),
+                                             OS_Ulong id, OS_Ulong initial,
+                                             OS_Ulong reload, OS_Uint auto_act)
+{ (void)storage; return os_timer_create(t, name, cb, id, initial, reload, auto_act); }
+static inline OS_Uint os_timer_delete_static(OS_Timer *t) { return os_timer_delete(t); }
+#endif /* HF_RTOS_STATIC_ALLOCATION */
+
+/* ISR-safe variants — non-blocking forwards to the stubs above */
+typedef int OS_IsrWoken;
+
+static inline int  os_in_isr(void)                      { return 0; }
+static inline void os_yield_from_isr(OS_IsrWoken woken) { (void)woken; }
+
+static inline OS_Uint os_thread_notify_give_from_isr(OS_Thread *t, OS_IsrWoken *woken)
+{ (void)woken; return os_thread_notify_give(t); }
+static inline OS_Uint os_semaphore_put_from_isr(OS_Semaphore *s, OS_IsrWoken *woken)
+{ (void)woken; return os_semaphore_put(s); }
+static inline OS_Uint os_semaphore_get_from_isr(OS_Semaphore *s, OS_IsrWoken *woken)
+{ (void)woken; return os_semaphore_get(s, OS_NO_WAIT); }
+static inline OS_Uint os_queue_send_from_isr(OS_Queue *q, const void *msg, OS_IsrWoken *woken)
+{ (void)woken; return os_queue_send(q, msg, OS_NO_WAIT); }
+static inline OS_Uint os_queue_receive_from_isr(OS_Queue *q, void *msg, OS_IsrWoken *woken)
+{ (void)woken; return os_queue_receive(q, msg, OS_NO_WAIT); }
+static inline OS_Uint os_event_group_set_from_isr(OS_EventGroup *g, OS_Ulong flags, OS_IsrWoken *woken)
+{ (void)woken; return os_event_group_set(g, flags); }
+static inline OS_Uint os_timer_activate_from_isr(OS_Timer *t, OS_IsrWoken *woken)
+{ (void)woken; return os_timer_activate(t); }
+static inline OS_Uint os_timer_deactivate_from_isr(OS_Timer *t, OS_IsrWoken *woken)
+{ (void)woken; return os_timer_deactivate(t); }
+static inline OS_Uint os_stream_buffer_send_from_isr(OS_StreamBuffer *b, const void *data, size_t len, OS_IsrWoken *woken)
+{ (void)woken; return os_stream_buffer_send(b, data, len, OS_NO_WAIT); }
+static inline OS_Uint os_stream_buffer_receive_from_isr(OS_StreamBuffer *b, void *data, size_t len, OS_IsrWoken *woken)
+{ (void)woken; return os_stream_buffer_receive(b, data, len, OS_NO_WAIT); }
+
 /* Critical section — no-ops (single-threaded) */
 typedef int OS_Critical;
 static inline void os_critical_enter(void) {}
@@ -417,5 +1261,5 @@ static inline void os_critical_exit(void)  {}
 }
 #endif
 
-#endif /* HF_RTOS_FREERTOS / HF_RTOS_NONE */
+#endif /* HF_RTOS_FREERTOS / HF_RTOS_POSIX / HF_RTOS_NONE */
 
@@ -6,7 +6,9 @@
  * is already MT-safe, so no extra mutex is layered on top.
  *
  * Allocation: the underlying RTOS handle is created eagerly in the
- * constructor; no heap allocation in `Set` / `Clear` / `Wait`.
+ * constructor; no heap allocation in `Set` / `Clear` / `Wait`. With
+ * `HF_RTOS_STATIC_ALLOCATION` the control block is a member and the
+ * constructor does not allocate either.
  *
  * Public surface uses modern C++ types (`uint32_t`, `enum class WaitMode`) —
  * no `OS_Ulong`, `OS_OR`, `OS_AND`, `OS_WAIT_FOREVER` leakage. Pass
@@ -19,6 +21,8 @@
 #include <climits>
 #include "OsAbstraction.h"
 #include "OsUtility.h"
+#include "IsrYieldScope.h"
+#include "WakeTarget.h"
 
 /**
  * @enum WaitMode
@@ -41,7 +45,11 @@ public:
     explicit OsEventFlags(const char* groupName) noexcept
         : name_(groupName)
     {
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+        created_ = os_event_flags_create_static_ex(group_, storage_, name_);
+#else
         created_ = os_event_flags_create_ex(group_, name_);
+#endif
     }
 
     OsEventFlags(const OsEventFlags&) = delete;
@@ -63,7 +71,36 @@ public:
     bool Set(uint32_t bits) noexcept
     {
         if (!created_) return false;
-        return os_event_flags_set_ex(group_, static_cast<OS_Ulong>(bits));
+        const bool set = os_event_flags_set_ex(group_, static_cast<OS_Ulong>(bits));
+        if (set && (bits & wakeBits_) != 0U) (void)wake_.Signal();
+        return set;
+    }
+
+    /**
+     * @brief Set @p bits from an interrupt handler.
+     *
+     * On FreeRTOS the set is deferred to the timer service task; this fails
+     * if its command queue is full.
+     *
+     * @param yield Collects the task-woken flag for the handler.
+     */
+    bool SetFromIsr(uint32_t bits, IsrYieldScope& yield) noexcept
+    {
+        if (!created_) return false;
+        const bool set = os_event_group_set_from_isr(&group_, static_cast<OS_Ulong>(bits),
+                                                     yield.Flag()) == OS_SUCCESS;
+        if (set && (bits & wakeBits_) != 0U) (void)wake_.SignalFromIsr(yield);
+        return set;
+    }
+
+    /**
+     * @brief Wake @p target whenever any of @p bits is set. Attach before the
+     *        first Set; pass an empty WakeTarget to detach.
+     */
+    void SetWakeTarget(const WakeTarget& target, uint32_t bits = UINT32_MAX) noexcept
+    {
+        wake_     = target;
+        wakeBits_ = bits;
     }
 
     /**
@@ -99,7 +136,9 @@ public:
         const bool ok = os_event_flags_get_ex(group_, static_cast<OS_Ulong>(bits),
                                               option, actual, ToTicks(timeout_ms));
         actual_bits = static_cast<uint32_t>(actual);
-        return ok;
+        // The RTOS call reports the bits seen even when it timed out.
+        const uint32_t seen = actual_bits & bits;
+        return ok && ((mode == WaitMode::All) ? (seen == bits) : (seen != 0U));
     }
 
 private:
@@ -113,6 +152,11 @@ private:
     const char*   name_;
     bool          created_{false};
     OS_EventGroup group_{};
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_EventGroupStorage storage_{};
+#endif
+    WakeTarget    wake_{};
+    uint32_t      wakeBits_{0};
 };
 
 #endif /* OS_EVENT_FLAGS_H_ */
@@ -0,0 +1,325 @@
+/**
+ * @file OsMpmcQueue.h
+ * @brief Lock-free bounded multi-producer / multi-consumer queue with the
+ *        `OsQueue` surface.
+ *
+ * A power-of-two array of cells, each carrying a sequence number that tells
+ * producers and consumers whether the cell is free for the current lap. A
+ * send or receive claims a position with one compare-and-swap on its own
+ * cache-line-aligned counter and then touches only its cell, so producers on
+ * both cores never take the kernel lock that every `xQueueSend` does.
+ *
+ * `Send` / `Receive` block only when the queue is full / empty. Waiters
+ * register in a counter and sleep on a counting semaphore; the other side
+ * posts a token only if it claims a registered waiter, so an unblocked
+ * hand-off makes no kernel call.
+ *
+ * Thread-safety: any number of producer and consumer tasks and interrupts.
+ * Lock-free, not wait-free: a producer preempted between claiming a cell and
+ * filling it makes consumers see that cell (and only that cell) as empty
+ * until it resumes.
+ *
+ * Allocation: cells and semaphore control blocks are inline members (the
+ * semaphores are created eagerly in the constructor); no heap allocation
+ * under `HF_RTOS_STATIC_ALLOCATION`.
+ *
+ * Switching from `OsQueue<T, N>` is a type change as long as `N` is a power
+ * of two. Timeouts are `uint32_t` milliseconds; `UINT32_MAX` waits forever.
+ */
+#ifndef OS_MPMC_QUEUE_H_
+#define OS_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <type_traits>
+#include "OsAbstraction.h"
+#include "OsUtility.h"
+#include "IsrYieldScope.h"
+#include "WakeTarget.h"
+
+/**
+ * @class OsMpmcQueue
+ * @brief Fixed-capacity MPMC queue of trivially-copyable items.
+ *
+ * @tparam MessageType  Element type (trivially copyable).
+ * @tparam kCapacity    Maximum number of pending elements; a power of two.
+ */
+template <typename MessageType, size_t kCapacity>
+class OsMpmcQueue {
+    static_assert(std::is_trivially_copyable_v<MessageType>,
+                  "OsMpmcQueue<T> requires a trivially copyable T");
+    static_assert(kCapacity >= 2U && (kCapacity & (kCapacity - 1U)) == 0U,
+                  "OsMpmcQueue capacity must be a power of two");
+
+public:
+    /**
+     * @brief Construct and create the blocking-fallback semaphores eagerly.
+     */
+    explicit OsMpmcQueue(const char* queueName) noexcept
+        : name_(queueName)
+    {
+        for (size_t i = 0; i < kCapacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+        notEmptyCreated_ = os_semaphore_create_static(&notEmpty_, &notEmptyStorage_, name_, 0) == OS_SUCCESS;
+        notFullCreated_ = os_semaphore_create_static(&notFull_, &notFullStorage_, name_, 0) == OS_SUCCESS;
+#else
+        notEmptyCreated_ = os_semaphore_create(&notEmpty_, name_, 0) == OS_SUCCESS;
+        notFullCreated_ = os_semaphore_create(&notFull_, name_, 0) == OS_SUCCESS;
+#endif
+    }
+
+    OsMpmcQueue(const OsMpmcQueue&) = delete;
+    OsMpmcQueue& operator=(const OsMpmcQueue&) = delete;
+
+    ~OsMpmcQueue() noexcept
+    {
+        if (notEmptyCreated_) {
+            (void)os_semaphore_delete(&notEmpty_);
+        }
+        if (notFullCreated_) {
+            (void)os_semaphore_delete(&notFull_);
+        }
+    }
+
+    /// True if both blocking-fallback semaphores were created successfully.
+    [[nodiscard]] bool IsValid() const noexcept { return notEmptyCreated_ && notFullCreated_; }
+
+    /**
+     * @brief Enqueue without blocking. Lock-free.
+     * @return true on success, false if the queue is full.
+     */
+    bool TrySend(const MessageType& message) noexcept
+    {
+        if (!Push(message)) return false;
+        Wake(consumerWaiters_, notEmpty_);
+        (void)wake_.Signal();
+        return true;
+    }
+
+    /**
+     * @brief Dequeue without blocking. Lock-free.
+     * @return true on success, false if the queue is empty.
+     */
+    bool TryReceive(MessageType& out) noexcept
+    {
+        if (!Pop(out)) return false;
+        Wake(producerWaiters_, notFull_);
+        return true;
+    }
+
+    /**
+     * @brief Enqueue; blocks up to @p timeout_ms while the queue is full.
+     * @return true on success, false on timeout.
+     */
+    bool Send(const MessageType& message, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        return Blocking(producerWaiters_, notFull_, timeout_ms,
+                        [&]() noexcept { return TrySend(message); });
+    }
+
+    /**
+     * @brief Dequeue; blocks up to @p timeout_ms while the queue is empty.
+     * @return true on success, false on timeout.
+     */
+    bool Receive(MessageType& out, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        return Blocking(consumerWaiters_, notEmpty_, timeout_ms,
+                        [&]() noexcept { return TryReceive(out); });
+    }
+
+    /**
+     * @brief Enqueue from an interrupt handler; never blocks.
+     * @param yield Collects the task-woken flag for the handler.
+     * @return true on success, false if the queue is full.
+     */
+    bool SendFromIsr(const MessageType& message, IsrYieldScope& yield) noexcept
+    {
+        if (!Push(message)) return false;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (Claim(consumerWaiters_)) {
+            (void)os_semaphore_put_from_isr(&notEmpty_, yield.Flag());
+        }
+        (void)wake_.SignalFromIsr(yield);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue from an interrupt handler; never blocks.
+     * @param yield Collects the task-woken flag for the handler.
+     * @return true on success, false if the queue is empty.
+     */
+    bool ReceiveFromIsr(MessageType& out, IsrYieldScope& yield) noexcept
+    {
+        if (!Pop(out)) return false;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (Claim(producerWaiters_)) {
+            (void)os_semaphore_put_from_isr(&notFull_, yield.Flag());
+        }
+        return true;
+    }
+
+    /**
+     * @brief Wake @p target after every successful send. Attach before the
+     *        first send; pass an empty WakeTarget to detach.
+     */
+    void SetWakeTarget(const WakeTarget& target) noexcept { wake_ = target; }
+
+    /**
+     * @brief Approximate number of pending elements (a snapshot of two
+     *        counters that other tasks may be moving).
+     */
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        const size_t tail = enqueuePos_.load(std::memory_order_acquire);
+        const size_t head = dequeuePos_.load(std::memory_order_acquire);
+        const size_t size = tail - head;
+        return (size > kCapacity) ? 0U : size;
+    }
+
+    /**
+     * @brief Compile-time capacity in elements.
+     */
+    [[nodiscard]] static constexpr size_t Capacity() noexcept { return kCapacity; }
+
+    /**
+     * @brief Total RAM held by one queue: cells, semaphore control blocks
+     *        and cache-line padding. Nothing else is allocated.
+     */
+    [[nodiscard]] static constexpr size_t FootprintBytes() noexcept { return sizeof(OsMpmcQueue); }
+
+private:
+    static constexpr size_t kMask = kCapacity - 1U;
+
+    /// A cell is free for the producer at position p when sequence == p and
+    /// holds that producer's item when sequence == p + 1.
+    struct Cell {
+        std::atomic<size_t> sequence;
+        MessageType         data;
+    };
+
+    bool Push(const MessageType& message) noexcept
+    {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[pos & kMask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (lap == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) break;
+            } else if (lap < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = message;
+        cell->sequence.store(pos + 1U, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(MessageType& out) noexcept
+    {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[pos & kMask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1U);
+            if (lap == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) break;
+            } else if (lap < 0) {
+                return false;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        out = cell->data;
+        cell->sequence.store(pos + kCapacity, std::memory_order_release);
+        return true;
+    }
+
+    /// Take one registration off @p waiters; false if nobody is registered.
+    static bool Claim(std::atomic<uint32_t>& waiters) noexcept
+    {
+        uint32_t count = waiters.load(std::memory_order_relaxed);
+        while (count != 0U) {
+            if (waiters.compare_exchange_weak(count, count - 1U, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    /// Pairs with the fence in Blocking(): either the waiter sees the new
+    /// state on its re-check, or we see its registration and post a token.
+    static void Wake(std::atomic<uint32_t>& waiters, OS_Semaphore& tokens) noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (Claim(waiters)) {
+            (void)os_semaphore_put(&tokens);
+        }
+    }
+
+    template <typename TryOnce>
+    bool Blocking(std::atomic<uint32_t>& waiters, OS_Semaphore& tokens, uint32_t timeout_ms, TryOnce tryOnce) noexcept
+    {
+        if (tryOnce()) return true;
+        if (timeout_ms == 0U || !IsValid()) return false;
+
+        const uint64_t deadlineUs = os_time_get_us() + static_cast<uint64_t>(timeout_ms) * 1000ULL;
+        while (true) {
+            /// Register, then re-check before sleeping. A registration that
+            /// was already claimed when we drop it leaves its token behind;
+            /// the next sleeper takes it as a spurious wake and re-checks.
+            waiters.fetch_add(1U, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (tryOnce()) {
+                (void)Claim(waiters);
+                return true;
+            }
+
+            OS_Ulong ticks = static_cast<OS_Ulong>(OS_WAIT_FOREVER);
+            if (timeout_ms != UINT32_MAX) {
+                const uint64_t nowUs = os_time_get_us();
+                if (nowUs >= deadlineUs) {
+                    (void)Claim(waiters);
+                    return false;
+                }
+                const uint32_t remainingMs = static_cast<uint32_t>((deadlineUs - nowUs + 999U) / 1000U);
+                ticks = static_cast<OS_Ulong>(os_convert_msec_to_delay_ticks(remainingMs));
+                if (ticks == 0U) ticks = 1U;  /// Never round a non-zero wait down to a poll.
+            }
+
+            if (os_semaphore_get(&tokens, ticks) != OS_SUCCESS) {
+                (void)Claim(waiters);
+            }
+            if (tryOnce()) return true;
+        }
+    }
+
+    /// Producer-side position and waiters on their own line.
+    alignas(HF_RTOS_CACHE_LINE_BYTES) std::atomic<size_t> enqueuePos_{0};
+    std::atomic<uint32_t> producerWaiters_{0};
+
+    /// Consumer-side position and waiters on their own line.
+    alignas(HF_RTOS_CACHE_LINE_BYTES) std::atomic<size_t> dequeuePos_{0};
+    std::atomic<uint32_t> consumerWaiters_{0};
+
+    alignas(HF_RTOS_CACHE_LINE_BYTES) Cell cells_[kCapacity];
+
+    const char*  name_;
+    bool         notEmptyCreated_{false};
+    bool         notFullCreated_{false};
+    OS_Semaphore notEmpty_{};
+    OS_Semaphore notFull_{};
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_SemaphoreStorage notEmptyStorage_{};
+    OS_SemaphoreStorage notFullStorage_{};
+#endif
+    WakeTarget   wake_{};
+};
+
+#endif /* OS_MPMC_QUEUE_H_ */
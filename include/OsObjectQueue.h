@@ -0,0 +1,179 @@
+/**
+ * @file OsObjectQueue.h
+ * @brief Typed queue for move-only and non-trivially-copyable messages.
+ *
+ * `OsQueue` copies messages through the kernel ring, so its items must be
+ * trivially copyable. `OsObjectQueue<T, N>` keeps the objects themselves in
+ * an inline slot array and passes only 32-bit slot indices through two
+ * kernel queues: one of free slots and one of pending slots, in FIFO order.
+ * `Emplace` constructs the object directly in its slot, and `Receive` moves
+ * it out and destroys the slot's copy. Objects still pending when the queue
+ * is destroyed are destroyed with it.
+ *
+ * Thread-safety: internally thread-safe for any number of producer and
+ * consumer tasks. There are no ISR forms, because constructing or destroying
+ * an arbitrary `T` is not interrupt-safe in general. `T`'s constructors and
+ * move assignment must not throw; the library is `noexcept` throughout.
+ *
+ * Allocation: slots and both index queues are inline members, created
+ * eagerly in the constructor; no heap allocation by the queue itself.
+ * `FootprintBytes()` reports the total.
+ *
+ * Timeouts are `uint32_t` milliseconds; `UINT32_MAX` waits forever.
+ */
+#ifndef OS_OBJECT_QUEUE_H_
+#define OS_OBJECT_QUEUE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "OsQueue.h"
+
+/**
+ * @class OsObjectQueue
+ * @brief Fixed-capacity MPMC queue that moves objects instead of copying bytes.
+ *
+ * @tparam MessageType  Element type; needs to be move-assignable, not copyable.
+ * @tparam kCapacity    Maximum number of pending elements.
+ */
+template <typename MessageType, size_t kCapacity>
+class OsObjectQueue {
+    static_assert(kCapacity > 0U && kCapacity <= UINT32_MAX, "OsObjectQueue capacity out of range");
+    static_assert(std::is_move_assignable_v<MessageType>,
+                  "OsObjectQueue<T> moves items out on Receive; T must be move-assignable");
+
+public:
+    /**
+     * @brief Construct both index queues eagerly and mark every slot free.
+     */
+    explicit OsObjectQueue(const char* queueName) noexcept
+        : free_(queueName), pending_(queueName)
+    {
+        for (size_t i = 0; i < kCapacity; ++i) {
+            (void)free_.Send(static_cast<uint32_t>(i), 0U);
+        }
+    }
+
+    OsObjectQueue(const OsObjectQueue&) = delete;
+    OsObjectQueue& operator=(const OsObjectQueue&) = delete;
+
+    /// Destroys any objects still pending.
+    ~OsObjectQueue() noexcept
+    {
+        uint32_t slot;
+        while (pending_.Receive(slot, 0U)) {
+            Slot(slot)->~MessageType();
+        }
+    }
+
+    /// True if both index queues were created successfully.
+    [[nodiscard]] bool IsValid() const noexcept { return free_.IsValid() && pending_.IsValid(); }
+
+    /**
+     * @brief Construct a message in place from @p args; waits forever for a
+     *        free slot.
+     * @return true on success, false on failure.
+     */
+    template <typename... Args>
+    bool Emplace(Args&&... args) noexcept
+    {
+        return EmplaceFor(UINT32_MAX, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Construct a message in place if a slot is free; never blocks.
+     * @return true on success, false if the queue is full.
+     */
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) noexcept
+    {
+        return EmplaceFor(0U, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Construct a message in place; blocks up to @p timeout_ms while
+     *        the queue is full.
+     * @return true on success, false on timeout / failure.
+     */
+    template <typename... Args>
+    bool EmplaceFor(uint32_t timeout_ms, Args&&... args) noexcept
+    {
+        uint32_t slot;
+        if (!free_.Receive(slot, timeout_ms)) return false;
+        ::new (static_cast<void*>(Slot(slot))) MessageType(std::forward<Args>(args)...);
+        /// Cannot fail: there are never more pending slots than the queue holds.
+        (void)pending_.Send(slot, 0U);
+        return true;
+    }
+
+    /**
+     * @brief Move @p message into the queue; blocks up to @p timeout_ms.
+     * @return true on success, false on timeout / failure (@p message is
+     *         left untouched).
+     */
+    bool Send(MessageType&& message, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        return EmplaceFor(timeout_ms, std::move(message));
+    }
+
+    /**
+     * @brief Copy @p message into the queue; blocks up to @p timeout_ms.
+     * @return true on success, false on timeout / failure.
+     */
+    template <typename T = MessageType, typename = std::enable_if_t<std::is_copy_constructible_v<T>>>
+    bool Send(const MessageType& message, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        return EmplaceFor(timeout_ms, message);
+    }
+
+    /**
+     * @brief Move the oldest message into @p out; blocks up to @p timeout_ms.
+     * @return true on success, false on timeout / failure.
+     */
+    bool Receive(MessageType& out, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        uint32_t slot;
+        if (!pending_.Receive(slot, timeout_ms)) return false;
+        MessageType* item = Slot(slot);
+        out = std::move(*item);
+        item->~MessageType();
+        (void)free_.Send(slot, 0U);
+        return true;
+    }
+
+    /**
+     * @brief Wake @p target after every successful send. Attach before the
+     *        first send; pass an empty WakeTarget to detach.
+     */
+    void SetWakeTarget(const WakeTarget& target) noexcept { pending_.SetWakeTarget(target); }
+
+    /**
+     * @brief Compile-time capacity in elements.
+     */
+    [[nodiscard]] static constexpr size_t Capacity() noexcept { return kCapacity; }
+
+    /**
+     * @brief Total RAM held by one queue: object slots and both index
+     *        queues. Nothing else is allocated.
+     */
+    [[nodiscard]] static constexpr size_t FootprintBytes() noexcept { return sizeof(OsObjectQueue); }
+
+private:
+    MessageType* Slot(uint32_t slot) noexcept
+    {
+        return std::launder(reinterpret_cast<MessageType*>(&slots_[slot]));
+    }
+
+    struct alignas(MessageType) SlotStorage {
+        unsigned char bytes[sizeof(MessageType)];
+    };
+
+    OsQueue<uint32_t, kCapacity> free_;
+    OsQueue<uint32_t, kCapacity> pending_;
+    SlotStorage                  slots_[kCapacity];
+};
+
+#endif /* OS_OBJECT_QUEUE_H_ */
@@ -5,9 +5,17 @@
  * Thread-safety: internally thread-safe; the underlying FreeRTOS queue is
  * already MT-safe so no extra mutex is layered on top.
  *
- * Allocation: queue storage is held inline as a fixed-capacity member array;
- * no heap allocation. The underlying RTOS queue handle is created eagerly in
- * the constructor.
+ * Allocation: the ring buffer and the queue control block are both inline
+ * members and the RTOS queue is built over them in place, eagerly in the
+ * constructor; no heap allocation. `FootprintBytes()` reports the total.
+ *
+ * `SendMany` / `ReceiveMany` / `DrainInto` move a whole batch per call: one
+ * wakeup and one lock round-trip per batch on the POSIX backend, one
+ * context-switch point per batch on FreeRTOS (see os_queue_send_many).
+ *
+ * `SendFromIsr` / `ReceiveFromIsr` are the interrupt-context forms; they
+ * never block. `SetWakeTarget` makes every successful send wake a consumer
+ * thread (see WakeTarget.h).
  *
  * Public surface uses modern C++ types — `uint32_t timeout_ms`, `bool`. No
  * `OS_Ulong` / `OS_WAIT_FOREVER` leakage. Pass `UINT32_MAX` to wait forever.
@@ -18,8 +26,14 @@
 #include <cstdint>
 #include <cstddef>
 #include <climits>
+#include <cstring>
+#if __has_include(<span>)
+#include <span>
+#endif
 #include "OsAbstraction.h"
 #include "OsUtility.h"
+#include "IsrYieldScope.h"
+#include "WakeTarget.h"
 
 /**
  * @class OsQueue
@@ -38,10 +52,9 @@ public:
     explicit OsQueue(const char* queueName) noexcept
         : name_(queueName)
     {
-        constexpr OS_Uint kItemWords =
-            static_cast<OS_Uint>((sizeof(MessageType) + sizeof(uint32_t) - 1U) / sizeof(uint32_t));
-        created_ = os_queue_create_ex(queue_, name_, kItemWords,
-                                      storage_, sizeof(storage_));
+        created_ = os_queue_create_static_ex(queue_, control_, name_,
+                                             static_cast<OS_Uint>(kItemWords),
+                                             storage_, static_cast<OS_Ulong>(kCapacity));
     }
 
     OsQueue(const OsQueue&) = delete;
@@ -64,8 +77,17 @@ public:
     bool Send(const MessageType& message, uint32_t timeout_ms = UINT32_MAX) noexcept
     {
         if (!created_) return false;
-        MessageType local = message;
-        return os_queue_send_ex(queue_, &local, ToTicks(timeout_ms));
+        bool sent;
+        if constexpr (kPadded) {
+            // The queue copies whole words; never read past the caller's object.
+            uint32_t words[kItemWords] = {};
+            std::memcpy(words, &message, sizeof(MessageType));
+            sent = os_queue_send_ex(queue_, words, ToTicks(timeout_ms));
+        } else {
+            sent = os_queue_send_ex(queue_, &message, ToTicks(timeout_ms));
+        }
+        if (sent) (void)wake_.Signal();
+        return sent;
     }
 
     /**
@@ -75,15 +97,175 @@ public:
     bool Receive(MessageType& out, uint32_t timeout_ms = UINT32_MAX) noexcept
     {
         if (!created_) return false;
-        return os_queue_receive_ex(queue_, &out, ToTicks(timeout_ms));
+        if constexpr (kPadded) {
+            uint32_t words[kItemWords];
+            if (!os_queue_receive_ex(queue_, words, ToTicks(timeout_ms))) return false;
+            std::memcpy(&out, words, sizeof(MessageType));
+            return true;
+        } else {
+            return os_queue_receive_ex(queue_, &out, ToTicks(timeout_ms));
+        }
+    }
+
+    /**
+     * @brief Send @p count messages in order; blocks up to @p timeout_ms in
+     *        total while the queue is full.
+     * @return Number of messages queued (a prefix of @p items); less than
+     *         @p count only on timeout / failure.
+     */
+    size_t SendMany(const MessageType* items, size_t count, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        if (!created_ || count == 0U) return 0;
+        size_t sent = 0;
+        if constexpr (kPadded) {
+            const uint64_t deadlineUs = Deadline(timeout_ms);
+            while (sent < count) {
+                uint32_t words[kStageItems * kItemWords] = {};
+                const size_t batch = (count - sent < kStageItems) ? (count - sent) : kStageItems;
+                for (size_t i = 0; i < batch; ++i) {
+                    std::memcpy(&words[i * kItemWords], &items[sent + i], sizeof(MessageType));
+                }
+                OS_Ulong moved = 0;
+                (void)os_queue_send_many(&queue_, words, static_cast<OS_Ulong>(batch), &moved,
+                                         Remaining(timeout_ms, deadlineUs));
+                sent += moved;
+                if (moved < batch) break;
+            }
+        } else {
+            OS_Ulong moved = 0;
+            (void)os_queue_send_many(&queue_, items, static_cast<OS_Ulong>(count), &moved, ToTicks(timeout_ms));
+            sent = moved;
+        }
+        if (sent != 0U) (void)wake_.Signal();
+        return sent;
+    }
+
+    /**
+     * @brief Receive up to @p maxCount messages; blocks up to @p timeout_ms
+     *        until at least @p minCount (clamped to the capacity) are
+     *        available, then takes everything pending that fits.
+     * @return Number of messages written to @p out; less than @p minCount
+     *         only on timeout / failure.
+     */
+    size_t ReceiveMany(MessageType* out, size_t maxCount, size_t minCount = 1U,
+                       uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        if (!created_ || maxCount == 0U) return 0;
+        if (minCount > maxCount) minCount = maxCount;
+        if (minCount > kCapacity) minCount = kCapacity;
+        if constexpr (kPadded) {
+            const uint64_t deadlineUs = Deadline(timeout_ms);
+            size_t received = 0;
+            while (received < maxCount) {
+                uint32_t words[kStageItems * kItemWords];
+                const size_t batch = (maxCount - received < kStageItems) ? (maxCount - received) : kStageItems;
+                const size_t needed = (received < minCount)
+                    ? ((minCount - received < batch) ? (minCount - received) : batch) : 0U;
+                OS_Ulong moved = 0;
+                (void)os_queue_receive_many(&queue_, words, static_cast<OS_Ulong>(batch),
+                                            static_cast<OS_Ulong>(needed), &moved,
+                                            (needed != 0U) ? Remaining(timeout_ms, deadlineUs) : static_cast<OS_Ulong>(OS_NO_WAIT));
+                for (size_t i = 0; i < moved; ++i) {
+                    std::memcpy(&out[received + i], &words[i * kItemWords], sizeof(MessageType));
+                }
+                received += moved;
+                if (moved < batch) break;
+            }
+            return received;
+        } else {
+            OS_Ulong moved = 0;
+            (void)os_queue_receive_many(&queue_, out, static_cast<OS_Ulong>(maxCount),
+                                        static_cast<OS_Ulong>(minCount), &moved, ToTicks(timeout_ms));
+            return moved;
+        }
+    }
+
+    /**
+     * @brief Take every pending message that fits in @p maxCount; never blocks.
+     * @return Number of messages written to @p out.
+     */
+    size_t DrainInto(MessageType* out, size_t maxCount) noexcept
+    {
+        return ReceiveMany(out, maxCount, 0U, 0U);
+    }
+
+#if defined(__cpp_lib_span)
+    /// `std::span` forms of the batch calls.
+    size_t SendMany(std::span<const MessageType> items, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        return SendMany(items.data(), items.size(), timeout_ms);
+    }
+    size_t ReceiveMany(std::span<MessageType> out, size_t minCount = 1U, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        return ReceiveMany(out.data(), out.size(), minCount, timeout_ms);
+    }
+    size_t DrainInto(std::span<MessageType> out) noexcept
+    {
+        return DrainInto(out.data(), out.size());
+    }
+#endif
+
+    /**
+     * @brief Send from an interrupt handler; never blocks.
+     * @param yield Collects the task-woken flag for the handler.
+     * @return true on success, false if the queue is full.
+     */
+    bool SendFromIsr(const MessageType& message, IsrYieldScope& yield) noexcept
+    {
+        if (!created_) return false;
+        bool sent;
+        if constexpr (kPadded) {
+            uint32_t words[kItemWords] = {};
+            std::memcpy(words, &message, sizeof(MessageType));
+            sent = os_queue_send_from_isr(&queue_, words, yield.Flag()) == OS_SUCCESS;
+        } else {
+            sent = os_queue_send_from_isr(&queue_, &message, yield.Flag()) == OS_SUCCESS;
+        }
+        if (sent) (void)wake_.SignalFromIsr(yield);
+        return sent;
+    }
+
+    /**
+     * @brief Receive from an interrupt handler; never blocks.
+     * @param yield Collects the task-woken flag for the handler.
+     * @return true on success, false if the queue is empty.
+     */
+    bool ReceiveFromIsr(MessageType& out, IsrYieldScope& yield) noexcept
+    {
+        if (!created_) return false;
+        if constexpr (kPadded) {
+            uint32_t words[kItemWords];
+            if (os_queue_receive_from_isr(&queue_, words, yield.Flag()) != OS_SUCCESS) return false;
+            std::memcpy(&out, words, sizeof(MessageType));
+            return true;
+        } else {
+            return os_queue_receive_from_isr(&queue_, &out, yield.Flag()) == OS_SUCCESS;
+        }
     }
 
+    /**
+     * @brief Wake @p target after every successful send. Attach before the
+     *        first send; pass an empty WakeTarget to detach.
+     */
+    void SetWakeTarget(const WakeTarget& target) noexcept { wake_ = target; }
+
     /**
      * @brief Compile-time capacity in elements.
      */
     [[nodiscard]] static constexpr size_t Capacity() noexcept { return kCapacity; }
 
+    /**
+     * @brief Total RAM held by one queue: ring buffer, RTOS control block
+     *        and wrapper bookkeeping. Nothing else is allocated.
+     */
+    [[nodiscard]] static constexpr size_t FootprintBytes() noexcept { return sizeof(OsQueue); }
+
 private:
+    /// Items travel through the RTOS queue as whole 32-bit words.
+    static constexpr size_t kItemWords =
+        (sizeof(MessageType) + sizeof(uint32_t) - 1U) / sizeof(uint32_t);
+    static constexpr bool kPadded = (kItemWords * sizeof(uint32_t)) != sizeof(MessageType);
+
     static OS_Ulong ToTicks(uint32_t timeout_ms) noexcept
     {
         return (timeout_ms == UINT32_MAX)
@@ -91,10 +273,30 @@ private:
             : static_cast<OS_Ulong>(os_convert_msec_to_delay_ticks(timeout_ms));
     }
 
+    /// Padded items are staged through a bounded word buffer on the stack.
+    static constexpr size_t kStageItems =
+        (kItemWords * sizeof(uint32_t) >= 256U) ? 1U : (256U / (kItemWords * sizeof(uint32_t)));
+
+    static uint64_t Deadline(uint32_t timeout_ms) noexcept
+    {
+        return os_time_get_us() + static_cast<uint64_t>(timeout_ms) * 1000ULL;
+    }
+
+    /// Ticks left of a batch-wide timeout that started at Deadline().
+    static OS_Ulong Remaining(uint32_t timeout_ms, uint64_t deadlineUs) noexcept
+    {
+        if (timeout_ms == UINT32_MAX) return static_cast<OS_Ulong>(OS_WAIT_FOREVER);
+        const uint64_t nowUs = os_time_get_us();
+        if (timeout_ms == 0U || nowUs >= deadlineUs) return static_cast<OS_Ulong>(OS_NO_WAIT);
+        return ToTicks(static_cast<uint32_t>((deadlineUs - nowUs + 999U) / 1000U));
+    }
+
     const char* name_;
     bool        created_{false};
-    OS_Queue    queue_{};
-    MessageType storage_[kCapacity];
+    OS_Queue        queue_{};
+    OS_QueueStorage control_{};
+    WakeTarget      wake_{};
+    uint32_t        storage_[kCapacity * kItemWords];
 };
 
 #endif /* OS_QUEUE_H_ */
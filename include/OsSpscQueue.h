@@ -0,0 +1,282 @@
+/**
+ * @file OsSpscQueue.h
+ * @brief Wait-free single-producer / single-consumer ring queue with a
+ *        blocking fallback.
+ *
+ * A power-of-two ring indexed by free-running head / tail counters that live
+ * on separate cache lines. `TrySend` / `TryReceive` are wait-free and make no
+ * kernel call; `Send` / `Receive` only block — on an event-group bit — when
+ * the ring is full / empty, and the other side sets that bit only if it sees
+ * a waiter, so an unblocked hand-off never enters the kernel.
+ *
+ * Thread-safety: exactly one producer task (or ISR, via `SendFromIsr`) and
+ * one consumer task (or ISR, via `ReceiveFromIsr`) at a time. Use `OsQueue`
+ * when there can be more.
+ *
+ * Allocation: ring and event-group control block are inline members (the
+ * event group is created eagerly in the constructor); no heap allocation
+ * under `HF_RTOS_STATIC_ALLOCATION`.
+ *
+ * `SetWakeTarget` makes every successful send wake a consumer thread (see
+ * WakeTarget.h). Timeouts are `uint32_t` milliseconds; `UINT32_MAX` waits
+ * forever.
+ */
+#ifndef OS_SPSC_QUEUE_H_
+#define OS_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <type_traits>
+#include "OsAbstraction.h"
+#include "OsUtility.h"
+#include "IsrYieldScope.h"
+#include "WakeTarget.h"
+
+/**
+ * @class OsSpscQueue
+ * @brief Fixed-capacity SPSC queue of trivially-copyable items.
+ *
+ * @tparam MessageType  Element type (trivially copyable).
+ * @tparam kCapacity    Maximum number of pending elements; a power of two.
+ */
+template <typename MessageType, size_t kCapacity>
+class OsSpscQueue {
+    static_assert(std::is_trivially_copyable_v<MessageType>,
+                  "OsSpscQueue<T> requires a trivially copyable T");
+    static_assert(kCapacity >= 2U && (kCapacity & (kCapacity - 1U)) == 0U,
+                  "OsSpscQueue capacity must be a power of two");
+
+public:
+    /**
+     * @brief Construct and create the blocking-fallback event group eagerly.
+     */
+    explicit OsSpscQueue(const char* queueName) noexcept
+        : name_(queueName)
+    {
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+        created_ = os_event_group_create_static(&events_, &eventsStorage_, name_) == OS_SUCCESS;
+#else
+        created_ = os_event_group_create(&events_, name_) == OS_SUCCESS;
+#endif
+    }
+
+    OsSpscQueue(const OsSpscQueue&) = delete;
+    OsSpscQueue& operator=(const OsSpscQueue&) = delete;
+
+    ~OsSpscQueue() noexcept
+    {
+        if (created_) {
+            (void)os_event_group_delete(&events_);
+        }
+    }
+
+    /// True if the blocking-fallback event group was created successfully.
+    [[nodiscard]] bool IsValid() const noexcept { return created_; }
+
+    /**
+     * @brief Enqueue without blocking. Producer side only; wait-free.
+     * @return true on success, false if the ring is full.
+     */
+    bool TrySend(const MessageType& message) noexcept
+    {
+        if (!Push(message)) return false;
+        NotifyConsumer();
+        (void)wake_.Signal();
+        return true;
+    }
+
+    /**
+     * @brief Dequeue without blocking. Consumer side only; wait-free.
+     * @return true on success, false if the ring is empty.
+     */
+    bool TryReceive(MessageType& out) noexcept
+    {
+        if (!Pop(out)) return false;
+        NotifyProducer();
+        return true;
+    }
+
+    /**
+     * @brief Enqueue; blocks up to @p timeout_ms while the ring is full.
+     * @return true on success, false on timeout.
+     */
+    bool Send(const MessageType& message, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        return Blocking(producerWaiting_, kNotFullBit, timeout_ms,
+                        [&]() noexcept { return TrySend(message); });
+    }
+
+    /**
+     * @brief Dequeue; blocks up to @p timeout_ms while the ring is empty.
+     * @return true on success, false on timeout.
+     */
+    bool Receive(MessageType& out, uint32_t timeout_ms = UINT32_MAX) noexcept
+    {
+        return Blocking(consumerWaiting_, kNotEmptyBit, timeout_ms,
+                        [&]() noexcept { return TryReceive(out); });
+    }
+
+    /**
+     * @brief Enqueue from an interrupt handler (as the single producer); never blocks.
+     * @param yield Collects the task-woken flag for the handler.
+     * @return true on success, false if the ring is full.
+     */
+    bool SendFromIsr(const MessageType& message, IsrYieldScope& yield) noexcept
+    {
+        if (!Push(message)) return false;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumerWaiting_.load(std::memory_order_relaxed) && created_) {
+            (void)os_event_group_set_from_isr(&events_, kNotEmptyBit, yield.Flag());
+        }
+        (void)wake_.SignalFromIsr(yield);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue from an interrupt handler (as the single consumer); never blocks.
+     * @param yield Collects the task-woken flag for the handler.
+     * @return true on success, false if the ring is empty.
+     */
+    bool ReceiveFromIsr(MessageType& out, IsrYieldScope& yield) noexcept
+    {
+        if (!Pop(out)) return false;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (producerWaiting_.load(std::memory_order_relaxed) && created_) {
+            (void)os_event_group_set_from_isr(&events_, kNotFullBit, yield.Flag());
+        }
+        return true;
+    }
+
+    /**
+     * @brief Wake @p target after every successful send. Attach before the
+     *        first send; pass an empty WakeTarget to detach.
+     */
+    void SetWakeTarget(const WakeTarget& target) noexcept { wake_ = target; }
+
+    /**
+     * @brief Number of pending elements; exact only when called from the
+     *        producer or the consumer.
+     */
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Compile-time capacity in elements.
+     */
+    [[nodiscard]] static constexpr size_t Capacity() noexcept { return kCapacity; }
+
+    /**
+     * @brief Total RAM held by one queue: ring, event-group control block
+     *        and cache-line padding. Nothing else is allocated.
+     */
+    [[nodiscard]] static constexpr size_t FootprintBytes() noexcept { return sizeof(OsSpscQueue); }
+
+private:
+    static constexpr size_t   kMask         = kCapacity - 1U;
+    static constexpr OS_Ulong kNotEmptyBit  = 0x1U;
+    static constexpr OS_Ulong kNotFullBit   = 0x2U;
+
+    bool Push(const MessageType& message) noexcept
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == kCapacity) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == kCapacity) return false;
+        }
+        slots_[tail & kMask] = message;
+        tail_.store(tail + 1U, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(MessageType& out) noexcept
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) return false;
+        }
+        out = slots_[head & kMask];
+        head_.store(head + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// Pairs with the fence in Blocking(): either the waiter sees the new
+    /// item on its re-check, or we see its flag and set the bit.
+    void NotifyConsumer() noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumerWaiting_.load(std::memory_order_relaxed) && created_) {
+            (void)os_event_group_set(&events_, kNotEmptyBit);
+        }
+    }
+
+    void NotifyProducer() noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (producerWaiting_.load(std::memory_order_relaxed) && created_) {
+            (void)os_event_group_set(&events_, kNotFullBit);
+        }
+    }
+
+    template <typename TryOnce>
+    bool Blocking(std::atomic<bool>& waiting, OS_Ulong bit, uint32_t timeout_ms, TryOnce tryOnce) noexcept
+    {
+        if (tryOnce()) return true;
+        if (timeout_ms == 0U || !created_) return false;
+
+        const uint64_t deadlineUs = os_time_get_us() + static_cast<uint64_t>(timeout_ms) * 1000ULL;
+        while (true) {
+            /// Clear a stale wake, announce the wait, then re-check before sleeping
+            (void)os_event_group_clear(&events_, bit);
+            waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (tryOnce()) {
+                waiting.store(false, std::memory_order_relaxed);
+                return true;
+            }
+
+            OS_Ulong ticks = static_cast<OS_Ulong>(OS_WAIT_FOREVER);
+            if (timeout_ms != UINT32_MAX) {
+                const uint64_t nowUs = os_time_get_us();
+                if (nowUs >= deadlineUs) {
+                    waiting.store(false, std::memory_order_relaxed);
+                    return false;
+                }
+                const uint32_t remainingMs = static_cast<uint32_t>((deadlineUs - nowUs + 999U) / 1000U);
+                ticks = static_cast<OS_Ulong>(os_convert_msec_to_delay_ticks(remainingMs));
+                if (ticks == 0U) ticks = 1U;  /// Never round a non-zero wait down to a poll.
+            }
+
+            OS_Ulong actual = 0;
+            (void)os_event_group_get(&events_, bit, static_cast<OS_Uint>(OS_OR), &actual, ticks);
+            waiting.store(false, std::memory_order_relaxed);
+            if (tryOnce()) return true;
+        }
+    }
+
+    /// Producer-owned line.
+    alignas(HF_RTOS_CACHE_LINE_BYTES) std::atomic<size_t> tail_{0};
+    size_t            headCache_{0};         ///< Producer's last view of head_.
+    std::atomic<bool> producerWaiting_{false};
+
+    /// Consumer-owned line.
+    alignas(HF_RTOS_CACHE_LINE_BYTES) std::atomic<size_t> head_{0};
+    size_t            tailCache_{0};         ///< Consumer's last view of tail_.
+    std::atomic<bool> consumerWaiting_{false};
+
+    alignas(HF_RTOS_CACHE_LINE_BYTES) MessageType slots_[kCapacity];
+
+    const char*   name_;
+    bool          created_{false};
+    OS_EventGroup events_{};
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_EventGroupStorage eventsStorage_{};
+#endif
+    WakeTarget    wake_{};
+};
+
+#endif /* OS_SPSC_QUEUE_H_ */
@@ -39,13 +39,22 @@ enum time_unit_t {
 
 #define UTIL_SYSTEM_CLOCK (240000000.0)	//240MHz
 
+/**
+ * @brief Padding unit that keeps producer- and consumer-owned atomics of the
+ *        lock-free queues on separate cache lines (covers the ESP32-S3 and
+ *        common host CPUs).
+ */
+#ifndef HF_RTOS_CACHE_LINE_BYTES
+#define HF_RTOS_CACHE_LINE_BYTES 64
+#endif
+
 #if defined(HF_RTOS_FREERTOS)
 static constexpr uint32_t osTickRateHz = configTICK_RATE_HZ; // 1000 ticks per second
 #else
-static constexpr uint32_t osTickRateHz = 1000; // Default 1 kHz assumed
+static constexpr uint32_t osTickRateHz = 1000; // Default 1 kHz assumed (POSIX backend: 1 tick = 1 ms)
 #endif
 
-#if defined(HF_RTOS_FREERTOS)
+#if defined(HF_RTOS_FREERTOS) || defined(HF_RTOS_POSIX)
 
 #ifdef __cplusplus
 extern "C" {
@@ -69,7 +78,7 @@ uint32_t os_get_elapsed_time_msec();
 }
 #endif
 
-#endif /* HF_RTOS_FREERTOS */
+#endif /* HF_RTOS_FREERTOS || HF_RTOS_POSIX */
 
 // ── Portable constexpr conversion utilities (work regardless of RTOS) ────
 /**
@@ -96,8 +105,8 @@ constexpr uint32_t os_convert_hz_to_delay_ticks( uint32_t frequency )
 	return osTickRateHz/frequency;
 }
 
-// ── FreeRTOS-specific declarations (implemented in OsUtility.cpp) ────────
-#if defined(HF_RTOS_FREERTOS)
+// ── RTOS-backed declarations (implemented in OsUtility.cpp) ──────────────
+#if defined(HF_RTOS_FREERTOS) || defined(HF_RTOS_POSIX)
 
 #ifdef __cplusplus
 extern "C" {
@@ -122,6 +131,9 @@ void os_delay_time(uint32_t timeBetweenSamples, time_unit_t timeUnit);
 /**
  * @brief Retrieves the elapsed time in milliseconds.
  *
+ * Derived from the microsecond clock (os_time_get_us()); wraps after ~49 days.
+ * Use os_time_get_us() directly for long intervals or sub-millisecond work.
+ *
  * @return The elapsed time in milliseconds.
  */
 uint32_t os_get_elapsed_time_msec();
@@ -129,8 +141,12 @@ uint32_t os_get_elapsed_time_msec();
 /**
  * @brief Function to get the elapsed time from a specified processor cycle count.
  * 		  The cycle count can be acquired through os_get_processor_cycle_count() function.
+ * 		  The interval must be shorter than one 32-bit counter period: ~17.9 s at
+ * 		  240 MHz on ESP32 (CCOUNT), and ~4.29 s on POSIX hosts and non-ESP
+ * 		  FreeRTOS, where the count is nanoseconds. Use os_time_get_us() for
+ * 		  longer intervals.
  *
- * @param startCycleCount :	value of the cycle count DWT->CYCCNT at first position of the program.
+ * @param startCycleCount :	value returned by os_get_processor_cycle_count() at the start of the interval.
  * @param unit 			  :	UNIT_MS,  if the result is requested in milliseconds.
  *							UNIT_US,  if the result is requested in microseconds.
  *							UNIT_SEC, if the result is requested in seconds.
@@ -141,7 +157,8 @@ uint32_t os_get_elapsed_processor_cycle_count(uint32_t startCycleCount, time_uni
 
 /**
  * @brief   Gets the processor's current cycle count
- * @return	Processor's current cycle count (DWT->CYCCNT)
+ * @return	Processor's current cycle count (CCOUNT on ESP32; low 32 bits of the
+ * 			nanosecond clock on backends without a portable cycle counter)
  */
 uint32_t os_get_processor_cycle_count();
 
@@ -268,6 +285,19 @@ bool os_thread_create_ex_pinned(OS_Thread* txThread, const char* name,
                     OS_Uint auto_start, int core_id,
                     bool suppressVerbose=true) noexcept;
 
+/**
+ * @brief os_thread_create_ex_pinned with a caller-owned start context.
+ *
+ * @param context  Trampoline context; must outlive the thread (typically a
+ *                 member of the owning object). Nothing is heap-allocated.
+ */
+bool os_thread_create_ctx_ex(OS_Thread* txThread, os_thread_start_t& context, const char* name,
+                    void (*entry_function)(OS_Ulong id), OS_Ulong entry_input,
+                    uint8_t* stack, OS_Ulong stackSizeBytes, OS_Uint priority,
+                    OS_Uint preempt_threshold, OS_Ulong timeSliceAllowed,
+                    OS_Uint auto_start, int core_id,
+                    bool suppressVerbose=true) noexcept;
+
 /**
  * @brief Resumes the specified OS thread.
  *
@@ -310,6 +340,20 @@ bool os_thread_delete_ex(OS_Thread *txThread, bool suppressVerbose=true) noexcep
 bool os_queue_create_ex(OS_Queue& queue, const char* queueName, OS_Uint messageSizeInWords,
                    void* queueStorage, OS_Ulong queueSize, bool suppressVerbose=true) noexcept;
 
+/**
+ * @brief Creates a queue in caller-provided storage (no heap allocation).
+ *
+ * @param queue - The OS queue to create
+ * @param control - Control block storage, valid until the queue is deleted
+ * @param queueName - The name for the queue
+ * @param messageSizeInWords - Item size in 32-bit words
+ * @param queueStorage - Ring buffer of queueLength * messageSizeInWords words
+ * @param queueLength - Capacity in items
+ */
+bool os_queue_create_static_ex(OS_Queue& queue, OS_QueueStorage& control, const char* queueName,
+                   OS_Uint messageSizeInWords, void* queueStorage, OS_Ulong queueLength,
+                   bool suppressVerbose=true) noexcept;
+
 /**
  * @brief Deletes the specified queue and logs any error.
  *
@@ -324,7 +368,7 @@ bool os_queue_delete_ex(OS_Queue& queue, bool suppressVerbose=true) noexcept;
  * @param message - The message to send
  * @param wait_option - The option on how to wait if the queue is full
  */
-bool os_queue_send_ex(OS_Queue& queue, void* message, OS_Ulong wait_option = OS_WAIT_FOREVER,
+bool os_queue_send_ex(OS_Queue& queue, const void* message, OS_Ulong wait_option = OS_WAIT_FOREVER,
                    bool suppressVerbose=true) noexcept;
 
 /**
@@ -365,6 +409,25 @@ bool os_timer_create_ex ( OS_Timer& timer, const char* name, void (*callback)(ui
   **/
 bool os_timer_deactivate_and_delete_ex( OS_Timer& timer, bool suppressVerbose=true) noexcept;
 
+/**
+  * @brief os_timer_create_ex with a caller-owned callback context.
+  *
+  * @param context Callback context; must stay valid until
+  *                os_timer_deactivate_and_delete_ctx_ex returns.
+  */
+bool os_timer_create_ctx_ex( OS_Timer& timer, os_timer_cb_t& context, const char* name,
+                     void (*callback)(uint32_t), uint32_t callbackExpirationInput,
+                     uint32_t initialTimeoutTicks, uint32_t rescheduleTimeoutTicks,
+                     OS_Uint autoActivate, bool suppressVerbose=true ) noexcept;
+
+/**
+  * @brief Stops and deletes a timer created by os_timer_create_ctx_ex.
+  *
+  * Returns once the timer service can no longer invoke the callback, so the
+  * context may be released immediately.
+  */
+bool os_timer_deactivate_and_delete_ctx_ex( OS_Timer& timer, bool suppressVerbose=true) noexcept;
+
 /**
   * @brief Activates a OS timer.
   *
@@ -475,6 +538,50 @@ bool os_event_flags_get_ex(OS_EventGroup& eventFlags, OS_Ulong flagsToGet,
                      OS_Uint getOption, OS_Ulong& actualFlags,
                      OS_Ulong wait_option, bool suppressVerbose=true) noexcept;
 
+//=============//
+// STATIC ALLOCATION
+//=============//
+
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+
+/**
+ * @brief Static-storage variants of the creation helpers above.
+ *
+ * Each takes the control-block storage the object is built in; the storage
+ * must stay valid until the matching delete helper returns. Nothing is
+ * allocated from the RTOS heap.
+ */
+bool os_mutex_create_static_ex(OS_Mutex& mutex, OS_MutexStorage& storage, const char* mutexName,
+                   OS_Uint priority = OS_INHERIT, bool suppressVerbose=true) noexcept;
+
+bool os_thread_create_static_ex(OS_Thread* txThread, OS_ThreadStorage& storage, const char* name,
+                    void (*entry_function)(OS_Ulong id), OS_Ulong entry_input,
+                    uint8_t* stack, OS_Ulong stackSizeBytes, OS_Uint priority,
+                    OS_Uint preempt_threshold, OS_Ulong timeSliceAllowed,
+                    OS_Uint auto_start, int core_id,
+                    bool suppressVerbose=true) noexcept;
+
+bool os_timer_create_static_ex(OS_Timer& timer, OS_TimerStorage& storage, const char* name,
+                     void (*callback)(uint32_t), uint32_t callbackExpirationInput,
+                     uint32_t initialTimeoutTicks, uint32_t rescheduleTimeoutTicks,
+                     OS_Uint autoActivate, bool suppressVerbose=true) noexcept;
+
+/**
+ * @brief Stops and deletes a timer created by os_timer_create_static_ex.
+ *
+ * Returns only once the timer service no longer references the storage.
+ */
+bool os_timer_deactivate_and_delete_static_ex(OS_Timer& timer, bool suppressVerbose=true) noexcept;
+
+bool os_semaphore_create_static_ex(OS_Semaphore* txSemaphore, OS_SemaphoreStorage& storage,
+                       const char* name, OS_Uint initial_count,
+                       bool suppressVerbose=true) noexcept;
+
+bool os_event_flags_create_static_ex(OS_EventGroup& eventFlags, OS_EventGroupStorage& storage,
+                       const char* name, bool suppressVerbose=true) noexcept;
+
+#endif /* HF_RTOS_STATIC_ALLOCATION */
+
 //=============//
 //=============//
 
@@ -482,7 +589,7 @@ bool os_event_flags_get_ex(OS_EventGroup& eventFlags, OS_Ulong flagsToGet,
 }
 #endif
 
-#endif /* HF_RTOS_FREERTOS — end of FreeRTOS-specific declarations */
+#endif /* HF_RTOS_FREERTOS || HF_RTOS_POSIX — end of RTOS-backed declarations */
 
 /* ═══════════════════════════════════════════════════════════════════════════
  * RTOS_NONE  — inline no-op stubs for _ex functions (OsUtility.cpp not compiled)
@@ -521,6 +628,9 @@ static inline bool os_thread_create_ex(OS_Thread*, const char*, void (*)(OS_Ulon
 static inline bool os_thread_create_ex_pinned(OS_Thread*, const char*, void (*)(OS_Ulong), OS_Ulong,
                                               uint8_t*, OS_Ulong, OS_Uint, OS_Uint, OS_Ulong,
                                               OS_Uint, int /*core_id*/, bool = true) noexcept { return true; }
+static inline bool os_thread_create_ctx_ex(OS_Thread*, os_thread_start_t&, const char*, void (*)(OS_Ulong), OS_Ulong,
+                                           uint8_t*, OS_Ulong, OS_Uint, OS_Uint, OS_Ulong,
+                                           OS_Uint, int /*core_id*/, bool = true) noexcept { return true; }
 static inline bool os_thread_resume_ex(OS_Thread*, bool = true) { return true; }
 static inline bool os_thread_resume_if_suspended(OS_Thread*, bool = true) noexcept { return true; }
 static inline bool os_thread_suspend_ex(OS_Thread*, bool = true) { return true; }
@@ -528,13 +638,16 @@ static inline bool os_thread_delete_ex(OS_Thread*, bool = true) noexcept { retur
 
 // Queue _ex stubs
 static inline bool os_queue_create_ex(OS_Queue&, const char*, OS_Uint, void*, OS_Ulong, bool = true) noexcept { return true; }
+static inline bool os_queue_create_static_ex(OS_Queue&, OS_QueueStorage&, const char*, OS_Uint, void*, OS_Ulong, bool = true) noexcept { return true; }
 static inline bool os_queue_delete_ex(OS_Queue&, bool = true) noexcept { return true; }
-static inline bool os_queue_send_ex(OS_Queue&, void*, OS_Ulong = 0xFFFFFFFFUL, bool = true) noexcept { return true; }
+static inline bool os_queue_send_ex(OS_Queue&, const void*, OS_Ulong = 0xFFFFFFFFUL, bool = true) noexcept { return true; }
 static inline bool os_queue_receive_ex(OS_Queue&, void*, OS_Ulong = 0xFFFFFFFFUL, bool = true) noexcept { return false; }
 
 // Timer _ex stubs
 static inline bool os_timer_create_ex(OS_Timer&, const char*, void (*)(uint32_t), uint32_t, uint32_t, uint32_t, OS_Uint, bool = true) noexcept { return true; }
 static inline bool os_timer_deactivate_and_delete_ex(OS_Timer&, bool = true) noexcept { return true; }
+static inline bool os_timer_create_ctx_ex(OS_Timer&, os_timer_cb_t&, const char*, void (*)(uint32_t), uint32_t, uint32_t, uint32_t, OS_Uint, bool = true) noexcept { return true; }
+static inline bool os_timer_deactivate_and_delete_ctx_ex(OS_Timer&, bool = true) noexcept { return true; }
 static inline bool os_timer_activate_ex(OS_Timer&, bool = true) noexcept { return true; }
 static inline bool os_timer_deactivate_ex(OS_Timer&, bool = true) noexcept { return true; }
 
@@ -552,6 +665,18 @@ static inline bool os_event_flags_set_ex(OS_EventGroup&, OS_Ulong, bool = true)
 static inline bool os_event_flags_clear_ex(OS_EventGroup&, OS_Ulong, bool = true) noexcept { return true; }
 static inline bool os_event_flags_get_ex(OS_EventGroup&, OS_Ulong, OS_Uint, OS_Ulong&, OS_Ulong, bool = true) noexcept { return true; }
 
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+// Static allocation _ex stubs
+static inline bool os_mutex_create_static_ex(OS_Mutex&, OS_MutexStorage&, const char*, OS_Uint = 0, bool = true) noexcept { return true; }
+static inline bool os_thread_create_static_ex(OS_Thread*, OS_ThreadStorage&, const char*, void (*)(OS_Ulong), OS_Ulong,
+                                              uint8_t*, OS_Ulong, OS_Uint, OS_Uint, OS_Ulong,
+                                              OS_Uint, int /*core_id*/, bool = true) noexcept { return true; }
+static inline bool os_timer_create_static_ex(OS_Timer&, OS_TimerStorage&, const char*, void (*)(uint32_t), uint32_t, uint32_t, uint32_t, OS_Uint, bool = true) noexcept { return true; }
+static inline bool os_timer_deactivate_and_delete_static_ex(OS_Timer&, bool = true) noexcept { return true; }
+static inline bool os_semaphore_create_static_ex(OS_Semaphore*, OS_SemaphoreStorage&, const char*, OS_Uint, bool = true) noexcept { return true; }
+static inline bool os_event_flags_create_static_ex(OS_EventGroup&, OS_EventGroupStorage&, const char*, bool = true) noexcept { return true; }
+#endif
+
 #endif /* HF_RTOS_NONE / HF_MCU_FAMILY_NONE */
 
 #endif // OS_UTILITY_H_
@@ -2,6 +2,13 @@
 /**
  * @file PeriodicTimer.h
  * @brief C++ wrapper for FreeRTOS timers.
+ *
+ * The callback context is a member, so `Create()` / `Destroy()` never
+ * allocate for it and timers can be churned at high rate. With
+ * `HF_RTOS_STATIC_ALLOCATION` the timer control block is a member too and
+ * the heap is not touched at all. Either way the timer refers into the
+ * object, which is why it is non-copyable. `Destroy()` returns only once the
+ * timer service can no longer run the callback.
  */
 
 #include "OsUtility.h"
@@ -15,8 +22,11 @@ public:
     /** Construct an empty timer. */
     PeriodicTimer() noexcept : timer{}, created(false) {}
 
+    PeriodicTimer(const PeriodicTimer&) = delete;
+    PeriodicTimer& operator=(const PeriodicTimer&) = delete;
+
     /** Delete timer on destruction. */
-    ~PeriodicTimer() { if (created) os_timer_deactivate_and_delete_ex(timer); }
+    ~PeriodicTimer() { if (created) DeleteTimer(); }
 
     /**
      * @brief Create a periodic timer.
@@ -32,8 +42,13 @@ public:
                 uint32_t periodMs, bool autoStart = false) noexcept {
         if (created) return false;
         uint32_t ticks = os_convert_msec_to_delay_ticks(periodMs);
-        created = os_timer_create_ex(timer, name, callback, arg, ticks, ticks,
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+        created = os_timer_create_static_ex(timer, storage, name, callback, arg, ticks, ticks,
+                                autoStart ? OS_AUTO_START : OS_DONT_START);
+#else
+        created = os_timer_create_ctx_ex(timer, context, name, callback, arg, ticks, ticks,
                                 autoStart ? OS_AUTO_START : OS_DONT_START);
+#endif
         return created;
     }
 
@@ -48,7 +63,7 @@ public:
         if (!created) {
             return true;
         }
-        bool res = os_timer_deactivate_and_delete_ex(timer);
+        bool res = DeleteTimer();
         if (res) created = false;
         return res;
     }
@@ -57,7 +72,20 @@ public:
     bool IsValid() const noexcept { return created; }
 
 private:
+    bool DeleteTimer() noexcept {
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+        return os_timer_deactivate_and_delete_static_ex(timer);
+#else
+        return os_timer_deactivate_and_delete_ctx_ex(timer);
+#endif
+    }
+
     OS_Timer timer;
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_TimerStorage storage{};
+#else
+    os_timer_cb_t context{};
+#endif
     bool created;
 };
 
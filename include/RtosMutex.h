@@ -38,15 +38,18 @@ class RtosTime {
 public:
   /**
    * @brief Get current time in microseconds.
-   * @return Current time in microseconds from the RTOS tick counter.
+   * @return Microseconds from the monotonic clock (os_time_get_us()).
    */
   static uint64_t GetCurrentTimeUs() noexcept {
-#if defined(HF_RTOS_NONE) || defined(HF_MCU_FAMILY_NONE)
-    return 0;
-#else
-    const uint32_t ticks = static_cast<uint32_t>(os_time_get());
-    return static_cast<uint64_t>(os_convert_delay_ticks_to_msec(ticks)) * 1000ULL;
-#endif
+    return os_time_get_us();
+  }
+
+  /**
+   * @brief Get current time in nanoseconds.
+   * @return Nanoseconds from the monotonic clock (os_time_get_ns()).
+   */
+  static uint64_t GetCurrentTimeNs() noexcept {
+    return os_time_get_ns();
   }
 
   /**
@@ -15,6 +15,9 @@
  * @par Thread-safety
  *   - Single writer assumed (`Publish` not safe to call concurrently from
  *     multiple writers; protect externally if ever needed).
+ *   - `PublishFromIsr` lets an interrupt handler be that single writer.
+ *     Never `Read` from an ISR that can preempt a task-context writer on
+ *     the same core: it would spin on the odd sequence forever.
  *   - Many readers — `Read` is wait-free in the absence of writes and
  *     bounded-retry under contention.
  *   - Optional waiter: backed by a lazily-created FreeRTOS event group;
@@ -22,7 +25,8 @@
  *
  * @par Allocation
  *   No heap allocation. Inline `T` storage; event group created on first
- *   `WaitForChange` / `ClearWaitEvent` use.
+ *   `WaitForChange` / `ClearWaitEvent` use (inline control block under
+ *   `HF_RTOS_STATIC_ALLOCATION`).
  *
  * @par Constraints
  *   `T` must be trivially copyable.
@@ -38,6 +42,8 @@
 #include <type_traits>
 
 #include "OsAbstraction.h"
+#include "IsrYieldScope.h"
+#include "WakeTarget.h"
 
 namespace hf {
 
@@ -104,15 +110,35 @@ public:
 
     void Publish(const T& value) noexcept override
     {
-        const uint32_t s0 = seq_.load(std::memory_order_relaxed);
-        seq_.store(s0 + 1U, std::memory_order_release);   // mark odd (writing)
-        std::atomic_thread_fence(std::memory_order_release);
-        std::memcpy(&payload_, &value, sizeof(T));
-        std::atomic_thread_fence(std::memory_order_release);
-        seq_.store(s0 + 2U, std::memory_order_release);   // back to even
+        Write_(value);
         SignalChange_();
+        (void)wake_.Signal();
     }
 
+    /**
+     * @brief `Publish` from an interrupt handler.
+     *
+     * The ISR must then be the only writer. Waiters are signalled only if a
+     * `WaitForChange` / `ClearWaitEvent` has already created the event group
+     * (it cannot be created from an ISR); otherwise nobody can be waiting.
+     *
+     * @param yield Collects the task-woken flag for the handler.
+     */
+    void PublishFromIsr(const T& value, IsrYieldScope& yield) noexcept
+    {
+        Write_(value);
+        if (event_group_created_) {
+            (void)os_event_group_set_from_isr(&event_group_, kEventBit_, yield.Flag());
+        }
+        (void)wake_.SignalFromIsr(yield);
+    }
+
+    /**
+     * @brief Wake @p target after every publish. Attach before the first
+     *        publish; pass an empty WakeTarget to detach.
+     */
+    void SetWakeTarget(const WakeTarget& target) noexcept { wake_ = target; }
+
     /* ── Reader ──────────────────────────────────────────────────── */
 
     uint32_t Read(T& out) const noexcept override
@@ -158,6 +184,16 @@ public:
     }
 
 private:
+    void Write_(const T& value) noexcept
+    {
+        const uint32_t s0 = seq_.load(std::memory_order_relaxed);
+        seq_.store(s0 + 1U, std::memory_order_release);   // mark odd (writing)
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&payload_, &value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_release);
+        seq_.store(s0 + 2U, std::memory_order_release);   // back to even
+    }
+
     void SignalChange_() noexcept
     {
         if (EnsureEventGroup_()) {
@@ -168,7 +204,11 @@ private:
     bool EnsureEventGroup_() noexcept
     {
         if (event_group_created_) return true;
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+        if (os_event_group_create_static(&event_group_, &event_group_storage_, "SeqlockSnap") == OS_SUCCESS) {
+#else
         if (os_event_group_create(&event_group_, "SeqlockSnap") == OS_SUCCESS) {
+#endif
             event_group_created_ = true;
         }
         return event_group_created_;
@@ -179,6 +219,10 @@ private:
     mutable std::atomic<uint32_t> seq_{0};
     T                             payload_{};
     OS_EventGroup                 event_group_{};
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_EventGroupStorage          event_group_storage_{};
+#endif
+    WakeTarget                    wake_{};
     bool                          event_group_created_{false};
 };
 
@@ -4,6 +4,18 @@
  *
  * The SignalSemaphore class provides a wrapper for a named semaphore that is dynamically
  * created. When the SignalSemaphore object goes out of scope, the semaphore is deleted.
+ * With HF_RTOS_STATIC_ALLOCATION the control block is embedded in the object instead.
+ *
+ * In Mode::TaskNotify the signal is delivered as a direct-to-task notification
+ * to a single waiter thread: no kernel object is created and signal-to-wake is
+ * roughly half the cost of a semaphore give/take. The waiter is bound with
+ * SetWaiter() or, failing that, by its first WaitUntilSignalled() call.
+ * Signals raised before a waiter is bound are counted and handed to the
+ * waiter when it binds, so none are lost (SignalFromIsr() still fails
+ * until then).
+ *
+ * SetWakeTarget() makes every successful signal also wake a consumer thread
+ * (see WakeTarget.h), e.g. a CoExecutor polling the semaphore.
  * @todo Add @copyright line once project copyright wording is finalised.
  */
 
@@ -11,7 +23,10 @@
 #define SIGNALSEMAPHORE_H
 
 #include <stdint.h>
+#include <atomic>
 #include "OsUtility.h"
+#include "IsrYieldScope.h"
+#include "WakeTarget.h"
 #include <cstdio>
 
 /**
@@ -20,6 +35,14 @@
 class SignalSemaphore
 {
 public:
+    /**
+     * @brief Primitive backing the signal.
+     */
+    enum class Mode : uint8_t {
+        Semaphore,   ///< RTOS counting semaphore; any task may wait.
+        TaskNotify,  ///< Notification of one bound waiter thread; no kernel object.
+    };
+
     /**
      * @brief Constructor for SignalSemaphore.
      * @param baseName Base name of the semaphore.
@@ -27,6 +50,14 @@ public:
      */
     SignalSemaphore(const char* baseName, const char* nameExtension = nullptr) noexcept;
 
+    /**
+     * @brief Constructor selecting the backing primitive.
+     * @param baseName Base name of the semaphore.
+     * @param nameExtension Optional name extension for uniqueness (may be nullptr).
+     * @param signalMode Backing primitive.
+     */
+    SignalSemaphore(const char* baseName, const char* nameExtension, Mode signalMode) noexcept;
+
     /**
      * @brief Deleted copy constructor to avoid copying instances.
      */
@@ -55,12 +86,40 @@ public:
      */
     bool Signal() noexcept;
 
+    /**
+     * @brief Signals the semaphore from an interrupt handler.
+     *
+     * Never creates the semaphore: fails if it has not been initialized yet
+     * (or, in Mode::TaskNotify, if no waiter is bound).
+     * @param yield Collects the task-woken flag for the handler.
+     * @return True if the semaphore was successfully signaled, false otherwise.
+     */
+    bool SignalFromIsr(IsrYieldScope& yield) noexcept;
+
     /**
      * @brief Checks if the semaphore is signaled.
      * @return True if the semaphore is signaled, false otherwise.
      */
     bool IsSignalled() noexcept;
 
+    /**
+     * @brief Binds the thread that waits on this signal (Mode::TaskNotify only).
+     * @param waiter Handle of the waiting thread.
+     * @return False in Mode::Semaphore or if a different waiter is already bound.
+     */
+    bool SetWaiter(OS_Thread waiter) noexcept;
+
+    /**
+     * @brief Wake @p target after every successful signal. Attach before the
+     *        first signal; pass an empty WakeTarget to detach.
+     */
+    void SetWakeTarget(const WakeTarget& target) noexcept { wake = target; }
+
+    /**
+     * @brief Gets the backing primitive.
+     */
+    Mode GetMode() const noexcept { return mode; }
+
     /**
      * @brief Ensures the semaphore is initialized.
      * @return True if the semaphore is initialized, false otherwise.
@@ -83,7 +142,19 @@ private:
 
     static constexpr uint32_t MaxNameLength = 39U;  ///< Maximum length of the semaphore name (excluding null terminator).
 
-    OS_Semaphore semaphore;  ///< The semaphore object.
+    Mode mode;  ///< Backing primitive.
+    /**
+     * @brief Give @p target every signal counted while no waiter was bound.
+     */
+    void FlushPendingSignals(OS_Thread target) noexcept;
+
+    std::atomic<OS_Thread> waiter;  ///< Bound waiter in Mode::TaskNotify.
+    std::atomic<uint32_t> pendingSignals;  ///< Signals raised before a waiter was bound.
+    OS_Semaphore semaphore;  ///< The semaphore object (Mode::Semaphore).
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+    OS_SemaphoreStorage semaphoreStorage;  ///< Control block backing `semaphore`.
+#endif
+    WakeTarget wake;  ///< Woken after every successful signal.
     char name[MaxNameLength + 1];  ///< The name of the semaphore.
     bool initialized;  ///< Indicates whether the semaphore is initialized.
 };
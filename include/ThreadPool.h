@@ -0,0 +1,471 @@
+#pragma once
+/**
+ * @file ThreadPool.h
+ * @brief Work-stealing pool of `BaseThread` workers spread across the cores.
+ *
+ * `ThreadPool<Workers, MaxTasks, TaskBytes>` runs small callables on
+ * `Workers` event-driven `BaseThread`s, worker `i` pinned to core
+ * `i % os_get_core_count()`. `Submit()` returns a `PoolHandle` the caller can
+ * `Wait()` on.
+ *
+ * Scheduling: a task submitted from a worker goes on the bottom of that
+ * worker's lock-free `WorkStealingDeque` (Chase-Lev), so fork/join work stays
+ * on the core that produced it; any other submitter puts it on a shared
+ * injection `OsQueue`. A worker runs its own deque LIFO, then the injection
+ * queue, then steals FIFO from the top of the other workers' deques. Idle
+ * workers sleep on their wake bit, and each submission wakes one of them.
+ *
+ * Thread-safety: `Submit`, `PoolHandle::Wait` / `IsDone` are safe from any
+ * task (not from interrupts). A task that needs the result of another task
+ * must wait with `ThreadPool::Wait(handle)`, which runs other queued tasks
+ * meanwhile; blocking a worker in `PoolHandle::Wait` can leave nothing to
+ * run the task it waits for.
+ *
+ * Allocation: none per task. Callables are constructed in one of `MaxTasks`
+ * inline `TaskBytes` slots; `Submit` fails (invalid handle) when none is
+ * free within its timeout. The constructor creates two queues and one
+ * completion semaphore per slot (inline under `HF_RTOS_STATIC_ALLOCATION`).
+ * The caller supplies the worker stacks.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "BaseThread.h"
+#include "OsQueue.h"
+#include "SignalSemaphore.h"
+
+/**
+ * @class WorkStealingDeque
+ * @brief Bounded Chase-Lev deque of 16-bit task indices.
+ *
+ * The owning thread pushes and pops at the bottom; any other thread steals
+ * from the top. Lock-free; follows Lê et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013), minus the resizing.
+ *
+ * `top_` / `bottom_` only ever grow, so they are unsigned and wrap; every
+ * comparison goes through the signed difference `b - t`, which stays within
+ * [-1, Capacity] however long the deque runs.
+ *
+ * @tparam Capacity  Power of two.
+ */
+template <size_t Capacity>
+class WorkStealingDeque {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1U)) == 0,
+                  "WorkStealingDeque capacity must be a power of two");
+
+public:
+    WorkStealingDeque() noexcept = default;
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /** Owner only. False if full. */
+    bool Push(uint16_t item) noexcept
+    {
+        const uint32_t b = bottom_.load(std::memory_order_relaxed);
+        const uint32_t t = top_.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(b - t) >= static_cast<int32_t>(Capacity)) return false;
+        items_[b & kMask].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1U, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** Owner only. Takes the most recently pushed item. */
+    bool Pop(uint16_t& item) noexcept
+    {
+        const uint32_t b = bottom_.load(std::memory_order_relaxed) - 1U;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t t = top_.load(std::memory_order_relaxed);
+        const int32_t size = static_cast<int32_t>(b - t);
+        if (size < 0) {
+            bottom_.store(b + 1U, std::memory_order_relaxed);
+            return false;
+        }
+        item = items_[b & kMask].load(std::memory_order_relaxed);
+        if (size == 0) {
+            // Last item: race the thieves for it.
+            const bool won = top_.compare_exchange_strong(t, t + 1U, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(b + 1U, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /** Any thread. Takes the oldest item; false if empty or another thief won it. */
+    bool Steal(uint16_t& item) noexcept
+    {
+        uint32_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint32_t b = bottom_.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(b - t) <= 0) return false;
+        item = items_[t & kMask].load(std::memory_order_relaxed);
+        return top_.compare_exchange_strong(t, t + 1U, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t kMask = Capacity - 1U;
+
+    std::atomic<uint32_t> top_{0};
+    std::atomic<uint32_t> bottom_{0};
+    std::atomic<uint16_t> items_[Capacity]{};
+};
+
+/**
+ * @brief Completion state of one task slot, shared with its `PoolHandle`s.
+ */
+struct PoolCompletion {
+    PoolCompletion() noexcept : done("PoolTask") {}
+
+    std::atomic<uint32_t> seq{0};      ///< Bumped each time a task in this slot finishes.
+    std::atomic<uint32_t> waiters{0};  ///< Threads blocked in PoolHandle::Wait().
+    SignalSemaphore       done;        ///< Given on completion while waiters > 0.
+};
+
+/**
+ * @class PoolHandle
+ * @brief Copyable ticket for one submitted task.
+ */
+class PoolHandle {
+public:
+    PoolHandle() noexcept = default;
+    PoolHandle(PoolCompletion* completion, uint32_t seq) noexcept
+        : completion_(completion), seq_(seq) {}
+
+    /** False if the submission failed. */
+    bool IsValid() const noexcept { return completion_ != nullptr; }
+
+    /** True once the task has run; false for an invalid handle. */
+    bool IsDone() const noexcept
+    {
+        return completion_ != nullptr && completion_->seq.load(std::memory_order_acquire) != seq_;
+    }
+
+    /**
+     * @brief [BLOCKING] Wait for the task to finish.
+     * @param timeoutMs Max wait in ms; `UINT32_MAX` waits forever.
+     * @return True if the task has run.
+     */
+    bool Wait(uint32_t timeoutMs = UINT32_MAX) noexcept
+    {
+        if (completion_ == nullptr) return false;
+        if (IsDone()) return true;
+
+        const uint64_t deadlineUs = os_time_get_us() + static_cast<uint64_t>(timeoutMs) * 1000U;
+        completion_->waiters.fetch_add(1, std::memory_order_seq_cst);
+        while (!IsDone()) {
+            uint32_t waitMs = UINT32_MAX;
+            if (timeoutMs != UINT32_MAX) {
+                const uint64_t now = os_time_get_us();
+                if (now >= deadlineUs) break;
+                waitMs = static_cast<uint32_t>((deadlineUs - now + 999U) / 1000U);
+            }
+            // The semaphore is shared by every task that reuses this slot, so
+            // a give may be stale: re-check the sequence after each wake.
+            (void)completion_->done.WaitUntilSignalled(waitMs);
+        }
+        // Pass a wake on to the next waiter of the same task.
+        if (completion_->waiters.fetch_sub(1, std::memory_order_seq_cst) > 1U && IsDone()) {
+            (void)completion_->done.Signal();
+        }
+        return IsDone();
+    }
+
+private:
+    PoolCompletion* completion_{nullptr};
+    uint32_t        seq_{0};
+};
+
+/**
+ * @class ThreadPool
+ * @brief Fixed-size work-stealing pool; see the file comment.
+ *
+ * @tparam Workers    Number of worker threads (1 .. 32).
+ * @tparam MaxTasks   Tasks that may be queued or running at once.
+ * @tparam TaskBytes  Largest callable `Submit` accepts, in bytes.
+ */
+template <size_t Workers, size_t MaxTasks = 32, size_t TaskBytes = 32>
+class ThreadPool {
+    static_assert(Workers > 0 && Workers <= 32, "ThreadPool supports 1 to 32 workers");
+    static_assert(MaxTasks > 0 && MaxTasks <= UINT16_MAX, "ThreadPool task count out of range");
+
+public:
+    /**
+     * @param name                 Name shared by the worker threads.
+     * @param stacks               `Workers * stackBytesPerWorker` bytes of caller-owned stack.
+     * @param stackBytesPerWorker  Stack size of each worker.
+     * @param priority             Priority of every worker.
+     */
+    ThreadPool(const char* name, uint8_t* stacks, uint32_t stackBytesPerWorker,
+               OS_Uint priority) noexcept
+        : freeSlots_(name), injected_(name)
+    {
+        const int cores = os_get_core_count();
+        for (size_t i = 0; i < Workers; ++i) {
+            workers_[i].Attach(this, name, static_cast<uint8_t>(i),
+                               stacks + i * stackBytesPerWorker, stackBytesPerWorker,
+                               priority, static_cast<int>(i) % cores);
+        }
+        for (size_t i = 0; i < MaxTasks; ++i) {
+            (void)slots_[i].completion.done.EnsureInitialized();
+            (void)freeSlots_.Send(static_cast<uint16_t>(i), 0);
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() noexcept
+    {
+        (void)Stop();
+        uint16_t index;
+        while (injected_.Receive(index, 0)) slots_[index].invoke(slots_[index].storage, false);
+        for (auto& worker : workers_) {
+            while (worker.deque.Pop(index)) slots_[index].invoke(slots_[index].storage, false);
+        }
+    }
+
+    /**
+     * @brief Create (first call) and start every worker.
+     * @return True if all workers report running.
+     */
+    bool Start(uint32_t timeoutMsec = 1000) noexcept
+    {
+        bool ok = true;
+        for (auto& worker : workers_) {
+            ok = worker.EnsureInitialized() && worker.StartThreadAndWaitToVerify(timeoutMsec) && ok;
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Stop every worker. Queued tasks stay queued until the next Start().
+     * @return True if all workers report stopped.
+     */
+    bool Stop(uint32_t timeoutMsec = 1000) noexcept
+    {
+        bool ok = true;
+        for (auto& worker : workers_) {
+            if (worker.IsThreadRunning()) {
+                ok = worker.StopThreadAndWaitToVerify(timeoutMsec) && ok;
+            }
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Queue @p fn to run once on some worker.
+     * @param timeoutMs How long to wait for a free task slot (0 = fail at once).
+     * @return Handle to wait on; invalid if no slot became free in time.
+     */
+    template <typename F>
+    PoolHandle Submit(F&& fn, uint32_t timeoutMs = 0) noexcept
+    {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= TaskBytes, "Callable too large for this ThreadPool's TaskBytes");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "Over-aligned callable");
+
+        uint16_t index;
+        if (!freeSlots_.Receive(index, timeoutMs)) return PoolHandle();
+
+        Slot& slot = slots_[index];
+        ::new (static_cast<void*>(slot.storage)) Fn(std::forward<F>(fn));
+        slot.invoke = &Invoke<Fn>;
+        const uint32_t seq = slot.completion.seq.load(std::memory_order_relaxed);
+
+        const int self = CurrentWorker();
+        if (self < 0 || !workers_[self].deque.Push(index)) {
+            (void)injected_.Send(index, 0);   // cannot fail: it holds MaxTasks indices
+        }
+        WakeOneIdle();
+        return PoolHandle(&slot.completion, seq);
+    }
+
+    /**
+     * @brief Wait for @p handle; on a worker of this pool, run other tasks
+     *        until it is done instead of blocking.
+     * @return True if the task has run.
+     */
+    bool Wait(PoolHandle& handle, uint32_t timeoutMs = UINT32_MAX) noexcept
+    {
+        const int self = CurrentWorker();
+        if (self < 0) return handle.Wait(timeoutMs);
+
+        const uint64_t startUs = os_time_get_us();
+        uint16_t index;
+        while (!handle.IsDone()) {
+            if (timeoutMs != UINT32_MAX &&
+                os_time_get_us() - startUs >= static_cast<uint64_t>(timeoutMs) * 1000U) {
+                return false;
+            }
+            if (FindWork(static_cast<uint8_t>(self), index)) {
+                Run(index);
+            } else {
+                (void)os_thread_sleep(0);   // the task is running elsewhere
+            }
+        }
+        return true;
+    }
+
+    /** Number of worker threads. */
+    static constexpr size_t WorkerCount() noexcept { return Workers; }
+
+    /** Worker @p index, e.g. for its step statistics or stack high-water mark. */
+    BaseThread& GetWorker(size_t index) noexcept { return workers_[index]; }
+
+private:
+    static constexpr size_t DequeCapacity() noexcept
+    {
+        size_t capacity = 1;
+        while (capacity < MaxTasks) capacity <<= 1;
+        return capacity;
+    }
+
+    struct Slot {
+        void (*invoke)(void* storage, bool run) noexcept = nullptr;
+        alignas(std::max_align_t) uint8_t storage[TaskBytes];
+        PoolCompletion completion;
+    };
+
+    class Worker : public BaseThread {
+    public:
+        Worker() noexcept : BaseThread("PoolWorker")
+        {
+            (void)SetScheduleMode(ScheduleMode::EventDriven);
+        }
+
+        void Attach(ThreadPool* pool, const char* name, uint8_t index, uint8_t* stack,
+                    uint32_t stackBytes, OS_Uint priority, int coreId) noexcept
+        {
+            pool_         = pool;
+            osThreadName  = name;
+            index_        = index;
+            stack_        = stack;
+            stackBytes_   = stackBytes;
+            priority_     = priority;
+            coreId_       = coreId;
+        }
+
+        /** True if @p thread is this worker's RTOS thread. */
+        bool Runs(OS_Thread thread) const noexcept { return osThreadCreated && osThread == thread; }
+
+        bool Setup() noexcept override { return true; }
+        bool Cleanup() noexcept override { return true; }
+
+        /** Run tasks until none is left anywhere, then sleep until woken. */
+        uint32_t Step() noexcept override
+        {
+            uint16_t index;
+            while (!IsThreadStopRequested()) {
+                if (!pool_->FindWork(index_, index)) {
+                    pool_->MarkIdle(index_);
+                    if (!pool_->FindWork(index_, index)) return UINT32_MAX;
+                    pool_->ClearIdle(index_);
+                }
+                pool_->Run(index);
+            }
+            return 0;
+        }
+
+        WorkStealingDeque<DequeCapacity()> deque;
+
+    protected:
+        bool Initialize() noexcept override
+        {
+            return CreateBaseThread(stack_, stackBytes_, priority_, 0, 0, OS_AUTO_START, coreId_);
+        }
+
+        bool ResetVariables() noexcept override { return true; }
+
+    private:
+        ThreadPool* pool_{nullptr};
+        uint8_t*    stack_{nullptr};
+        uint32_t    stackBytes_{0};
+        OS_Uint     priority_{0};
+        int         coreId_{-1};
+        uint8_t     index_{0};
+    };
+
+    template <typename Fn>
+    static void Invoke(void* storage, bool run) noexcept
+    {
+        Fn* fn = std::launder(static_cast<Fn*>(storage));
+        if (run) (*fn)();
+        fn->~Fn();
+    }
+
+    /** Index of the worker running the caller, or -1. */
+    int CurrentWorker() const noexcept
+    {
+        const OS_Thread self = os_thread_self();
+        if (self == OS_Thread{}) return -1;
+        for (size_t i = 0; i < Workers; ++i) {
+            if (workers_[i].Runs(self)) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    /** Own deque, then the injection queue, then the other workers' deques. */
+    bool FindWork(uint8_t self, uint16_t& index) noexcept
+    {
+        if (workers_[self].deque.Pop(index)) return true;
+        if (injected_.Receive(index, 0)) return true;
+        for (size_t n = 1; n < Workers; ++n) {
+            if (workers_[(self + n) % Workers].deque.Steal(index)) return true;
+        }
+        return false;
+    }
+
+    void Run(uint16_t index) noexcept
+    {
+        Slot& slot = slots_[index];
+        slot.invoke(slot.storage, true);
+        slot.completion.seq.fetch_add(1, std::memory_order_seq_cst);
+        if (slot.completion.waiters.load(std::memory_order_seq_cst) > 0U) {
+            (void)slot.completion.done.Signal();
+        }
+        (void)freeSlots_.Send(index, 0);
+    }
+
+    void MarkIdle(uint8_t worker) noexcept
+    {
+        idle_.fetch_or(1U << worker, std::memory_order_seq_cst);
+    }
+
+    void ClearIdle(uint8_t worker) noexcept
+    {
+        idle_.fetch_and(~(1U << worker), std::memory_order_relaxed);
+    }
+
+    /** Wake the lowest-numbered idle worker, if any. */
+    void WakeOneIdle() noexcept
+    {
+        // Pairs with MarkIdle(): either the worker sees the new task on its
+        // re-check, or we see its idle bit here.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t idle = idle_.load(std::memory_order_seq_cst);
+        while (idle != 0U) {
+            const uint32_t bit = idle & (~idle + 1U);
+            if (idle_.fetch_and(~bit, std::memory_order_acq_rel) & bit) {
+                (void)workers_[__builtin_ctz(bit)].Wake();
+                return;
+            }
+            idle = idle_.load(std::memory_order_seq_cst);
+        }
+    }
+
+    Slot                           slots_[MaxTasks];
+    OsQueue<uint16_t, MaxTasks>    freeSlots_;
+    OsQueue<uint16_t, MaxTasks>    injected_;
+    Worker                         workers_[Workers];
+    std::atomic<uint32_t>          idle_{0};
+};
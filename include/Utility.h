@@ -25,8 +25,9 @@
 template <typename Func, typename T>
 static inline bool TestLogicWithTimeout(Func func, T expected, uint32_t timeoutMsec, uint32_t checkIntervalMs)
 {
-    uint32_t start = os_get_elapsed_time_msec();
-    while ((os_get_elapsed_time_msec() - start) < timeoutMsec) {
+    const uint64_t start = os_time_get_us();
+    const uint64_t timeoutUs = static_cast<uint64_t>(timeoutMsec) * 1000ULL;
+    while ((os_time_get_us() - start) < timeoutUs) {
         if (func() == expected) {
             return true;
         }
@@ -0,0 +1,57 @@
+#pragma once
+/**
+ * @file WakeTarget.h
+ * @brief Handle that lets a producer wake a waiting consumer thread.
+ *
+ * A `WakeTarget` names one or more bits of a consumer's event group. A
+ * producer primitive (`OsQueue`, `OsEventFlags`, `SignalSemaphore`,
+ * `hf::SeqlockSnapshot`, `hf::FlagsSaver`) that has a target attached sets
+ * those bits after every successful send / set / signal / publish, so an
+ * event-driven `BaseThread` runs its `Step()` as soon as work arrives instead
+ * of polling for it.
+ *
+ * Obtain one from `BaseThread::GetWakeTarget()`; a default-constructed target
+ * is empty and `Signal()` on it does nothing.
+ *
+ * Thread-safety: `Signal` is safe from any task, `SignalFromIsr` from any
+ * interrupt. Attach a target before the producer is first used; the event
+ * group it names must outlive the producer.
+ *
+ * Allocation: none; a handle and a bit mask.
+ */
+
+#include <cstdint>
+#include "OsAbstraction.h"
+#include "IsrYieldScope.h"
+
+/**
+ * @class WakeTarget
+ * @brief Copyable (event group, bits) pair signalled by producers.
+ */
+class WakeTarget {
+public:
+    WakeTarget() noexcept = default;
+    WakeTarget(OS_EventGroup group, uint32_t bits) noexcept : group_(group), bits_(bits) {}
+
+    /** True if this target names an event group. */
+    bool IsValid() const noexcept { return bits_ != 0U; }
+
+    /** Set the target bits; no-op on an empty target. */
+    bool Signal() noexcept
+    {
+        if (bits_ == 0U) return false;
+        return os_event_group_set(&group_, static_cast<OS_Ulong>(bits_)) == OS_SUCCESS;
+    }
+
+    /** Set the target bits from an interrupt handler. */
+    bool SignalFromIsr(IsrYieldScope& yield) noexcept
+    {
+        if (bits_ == 0U) return false;
+        return os_event_group_set_from_isr(&group_, static_cast<OS_Ulong>(bits_),
+                                           yield.Flag()) == OS_SUCCESS;
+    }
+
+private:
+    OS_EventGroup group_{};
+    uint32_t      bits_{0};
+};
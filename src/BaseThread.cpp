@@ -10,7 +10,6 @@
 
 #include "BaseThread.h"
 #include "OsUtility.h"
-#include "Utility.h"
 
 //==============================================================//
 /// BASE THREAD ITEMS BASE NAMES
@@ -31,15 +30,35 @@ BaseThread::BaseThread( const char* threadName) :
 	osThread{},
     osThreadName( threadName ),   // TODO:  This should be a strncpy into a buffer
 	osThreadCreated( false),
-	signalSemaphore( baseThreadStartSemaphoreBaseName, threadName),
+	signalSemaphore( baseThreadStartSemaphoreBaseName, threadName, startSignalMode),
 
 	waitBeforeStep(0),
-	minTimestampBeforeNextStep(0),
+	scheduleMode(ScheduleMode::Delay),
+	overrunPolicy(OverrunPolicy::Skip),
+	overrunCount(0),
 	threadRunning(false),
 	threadStepInDelay(false),
 	setupComplete(false),
 	cleanupComplete(false),
-	stopThreadRequested(false)
+	stopThreadRequested(false),
+	threadEvents{},
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+	threadEventsStorage{},
+#endif
+	threadEventsCreated(false),
+	stepBudgetUs(0),
+	stepPeriodUs(0),
+	lastStepStartUs(0),
+	stepCount(0),
+	lastStepTick(0),
+	threadPriority(0),
+	threadCoreId(-1),
+	requestedCoreId(kNoCoreRequest),
+	cpuUsage(),
+	deadlineMisses(0),
+	consecutiveDeadlineMisses(0),
+	maxConsecutiveDeadlineMisses(0),
+	worstDeadlineOverrunUs(0)
 {
 	/// No code at this moment.
 }
@@ -55,6 +74,10 @@ BaseThread::~BaseThread()
 	{
 		os_thread_delete_ex( &osThread);
 	}
+	if( threadEventsCreated )
+	{
+		os_event_flags_delete_ex( threadEvents );
+	}
 }
 
 /**
@@ -93,17 +116,36 @@ bool BaseThread::CreateBaseThread( uint8_t* stack, OS_Ulong stackSizeBytes,
                                    OS_Ulong timeSliceAllowed, OS_Uint auto_start,
                                    int core_id ) noexcept
 {
+    /// A core chosen through SetCoreAffinity() wins over the one passed in
+    if( requestedCoreId != kNoCoreRequest )
+    {
+        core_id = requestedCoreId;
+    }
+
     /// Then, if the thread is not already created, create it
-    if(signalSemaphore.EnsureInitialized())
+    if(signalSemaphore.EnsureInitialized() && EnsureThreadEvents())
     {
       /// Create the OS Thread (pinned to `core_id` if >= 0, no affinity otherwise).
-           bool status = os_thread_create_ex_pinned(&osThread, const_cast<char*>(osThreadName), ThreadEntry,
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+           bool status = os_thread_create_static_ex(&osThread, osThreadStorage, osThreadName, ThreadEntry,
                                         reinterpret_cast<OS_Ulong>(this), stack,
                                         stackSizeBytes, priority, preempt_threshold,
                                        timeSliceAllowed, auto_start, core_id );
+#else
+           bool status = os_thread_create_ctx_ex(&osThread, osThreadStartContext, osThreadName, ThreadEntry,
+                                        reinterpret_cast<OS_Ulong>(this), stack,
+                                        stackSizeBytes, priority, preempt_threshold,
+                                       timeSliceAllowed, auto_start, core_id );
+#endif
 	   /// If successfully created
 	   if (status)
 	   {
+		   /// Route start signals to the new thread (it may already have bound itself).
+		   (void)signalSemaphore.SetWaiter(osThread);
+
+		   threadPriority.store(static_cast<uint32_t>(priority), std::memory_order_relaxed);
+		   threadCoreId.store(core_id, std::memory_order_relaxed);
+
 		   /// Mark the base thread as created.
 		   osThreadCreated = true;
 
@@ -162,7 +204,7 @@ bool BaseThread::IsSuspended() noexcept
             if( OS_SUCCESS == os_thread_info_get(&osThread, &state) )
 	    {
 	    	// Check if the thread is suspended
-                return (state == eSuspended) || (state == eBlocked);
+                return (state == OS_THREAD_SUSPENDED) || (state == OS_THREAD_BLOCKED);
 	    }
 
 	    return false;
@@ -199,12 +241,33 @@ bool BaseThread::Stop() noexcept
 {
     MarkThreadStopRequested();
 
+    /// Cut the step delay short so the stop is seen now.
+    (void)Wake();
+
     /// In case we are somehow suspended in our step, let's resume.
     os_thread_resume_if_suspended( &osThread );
 
     return true;
 }
 
+WakeTarget BaseThread::GetWakeTarget() noexcept
+{
+    if( !EnsureThreadEvents() )
+    {
+        return WakeTarget();
+    }
+    return WakeTarget( threadEvents, static_cast<uint32_t>(kThreadWakeBit) );
+}
+
+bool BaseThread::Wake() noexcept
+{
+    if( !threadEventsCreated )
+    {
+        return false;
+    }
+    return os_event_flags_set_ex( threadEvents, kThreadWakeBit );
+}
+
 void BaseThread::ThreadEntry( OS_Ulong threadEntry)
 {
     BaseThread* thread = reinterpret_cast<BaseThread*>(threadEntry);
@@ -217,26 +280,57 @@ void BaseThread::ThreadEntry( OS_Ulong threadEntry)
 
         thread->ResetVariables();		/// Reset all necessary variables
 
-        thread->MarkThreadRunning();		/**< Thread should be marked as running immediately. */
-
         thread->ClearThreadStopRequested(); /**< Clear this flag in case CALLER didn't wait to send START command until the mode was completely stopped
                                                  and then sent another STOP flag because CALLER doesn't see the mode starting, this should not be the case
                                                  in the final product but necessary during development. */
         thread->ClearCleanupComplete();		/**< Clear the cleanup complete flag. */
 
+        /// Drop a wake left over from the previous Stop().
+        if( thread->threadEventsCreated )
+        {
+            (void)os_event_flags_clear_ex( thread->threadEvents, kThreadWakeBit );
+        }
+
+        thread->MarkThreadRunning();		/**< Mark running only after the stop request is cleared, so a Stop() issued
+                                                 as soon as a verifier sees the thread running is never lost. */
+
         if( !thread->IsSetupComplete() )
         {
             thread->Setup();
             thread->MarkSetupComplete();
         }
 
+        OS_Ulong nextWake = os_time_get();	/// FixedRate deadlines are anchored at the first Step()
+        thread->lastStepStartUs = 0;			/// No interval check for the first Step() of a run
+        thread->consecutiveDeadlineMisses.store(0, std::memory_order_relaxed);
+#if defined(HF_BASETHREAD_STEP_STATS)
+        thread->expectedStepStartUs = 0;		/// No jitter sample for the first Step() of a run
+#endif
+
         while ( !thread->IsThreadStopRequested() )
         {
+        	const uint64_t stepStartUs = thread->StepTimestamp();
+        	thread->StepStatsBegin(stepStartUs);
+        	thread->lastStepTick.store(static_cast<uint32_t>(os_time_get()), std::memory_order_relaxed);
+        	thread->stepCount.store(thread->stepCount.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);	/// Only this thread writes
         	thread->waitBeforeStep = thread->Step(); 											/// Main control loop sequence
-        	thread->minTimestampBeforeNextStep = os_get_elapsed_time_msec() + thread->waitBeforeStep; /// Calculate next timestamp to Step() again
+        	const uint64_t stepEndUs = thread->StepTimestamp();
+        	thread->StepStatsEnd(stepStartUs, stepEndUs);
+        	thread->CheckStepDeadline(stepStartUs, stepEndUs);
 
 			thread->MarkThreadStepInDelay();							/// Mark that we are going to a delay
-			os_delay_msec(static_cast<uint16_t>(thread->waitBeforeStep));	/// Delay requested time
+			if( thread->scheduleMode == ScheduleMode::FixedRate )
+			{
+				thread->SleepUntilNextPeriod(nextWake);				/// Sleep until the next absolute deadline
+			}
+			else if( thread->scheduleMode == ScheduleMode::EventDriven && thread->waitBeforeStep == UINT32_MAX )
+			{
+				(void)thread->WaitForWake(static_cast<OS_Ulong>(OS_WAIT_FOREVER));	/// Idle until a producer or Stop() wakes us
+			}
+			else
+			{
+				(void)thread->WaitForWake(os_convert_msec_to_delay_ticks(thread->waitBeforeStep));	/// Delay requested time
+			}
 			thread->ClearThreadStepInDelay();							/// Clear that we are in a delay
         }
 
@@ -252,6 +346,196 @@ void BaseThread::ThreadEntry( OS_Ulong threadEntry)
     }
 }
 
+void BaseThread::SleepUntilNextPeriod(OS_Ulong& nextWake) noexcept
+{
+    /// Step() returned the period; never less than one tick.
+    OS_Ulong period = os_convert_msec_to_delay_ticks(waitBeforeStep);
+    if( period == 0 )
+    {
+        period = 1;
+    }
+
+    const OS_Ulong now = os_time_get();
+
+    /// nextWake is the release time of the Step() that just ran, unless a Wake() ran it early.
+    if( static_cast<long>(nextWake - now) <= 0 )
+    {
+        nextWake += period;
+    }
+
+    if( static_cast<long>(nextWake - now) > 0 )
+    {
+        (void)WaitForWake(nextWake - now);
+        return;
+    }
+
+    /// Step() finished after its deadline.
+    overrunCount.fetch_add(1, std::memory_order_relaxed);
+
+    if( overrunPolicy == OverrunPolicy::Skip )
+    {
+        /// Drop the missed deadlines and wait for the first one still ahead on the original grid.
+        nextWake += ((now - nextWake) / period + 1) * period;
+        (void)WaitForWake(nextWake - now);
+    }
+    /// CatchUp: the next Step() runs now; nextWake advances one period per Step().
+}
+
+bool BaseThread::WaitForWake(OS_Ulong ticks) noexcept
+{
+    if( ticks == 0 || !threadEventsCreated )
+    {
+        (void)os_thread_sleep(ticks);
+        return false;
+    }
+
+    /// Waiting for all of a single bit clears it on the way out.
+    OS_Ulong actual = 0;
+    (void)os_event_flags_get_ex( threadEvents, kThreadWakeBit, OS_AND, actual, ticks );
+    return (actual & kThreadWakeBit) != 0;
+}
+
+bool BaseThread::EnsureThreadEvents() noexcept
+{
+    if( !threadEventsCreated )
+    {
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+        threadEventsCreated = os_event_flags_create_static_ex( threadEvents, threadEventsStorage, osThreadName );
+#else
+        threadEventsCreated = os_event_flags_create_ex( threadEvents, osThreadName );
+#endif
+        PublishRunState( IsThreadRunning() );
+    }
+    return threadEventsCreated;
+}
+
+uint64_t BaseThread::StepTimestamp() const noexcept
+{
+#if defined(HF_BASETHREAD_STEP_STATS)
+    return os_time_get_us();
+#else
+    return (stepBudgetUs != 0 || stepPeriodUs != 0) ? os_time_get_us() : 0;
+#endif
+}
+
+void BaseThread::CheckStepDeadline(uint64_t stepStartUs, uint64_t stepEndUs) noexcept
+{
+    if( stepBudgetUs == 0 && stepPeriodUs == 0 )
+    {
+        return;
+    }
+
+    const uint64_t stepUs = stepEndUs - stepStartUs;
+    const uint64_t intervalUs = (lastStepStartUs != 0) ? (stepStartUs - lastStepStartUs) : 0;
+    lastStepStartUs = stepStartUs;
+
+    uint64_t overrunUs = 0;
+    if( stepBudgetUs != 0 && stepUs > stepBudgetUs )
+    {
+        overrunUs = stepUs - stepBudgetUs;
+    }
+    if( stepPeriodUs != 0 && intervalUs > stepPeriodUs && (intervalUs - stepPeriodUs) > overrunUs )
+    {
+        overrunUs = intervalUs - stepPeriodUs;
+    }
+
+    if( overrunUs == 0 )
+    {
+        consecutiveDeadlineMisses.store(0, std::memory_order_relaxed);
+        return;
+    }
+
+    /// Single writer (this thread): plain load / store is enough for the readers.
+    const uint32_t consecutive = consecutiveDeadlineMisses.load(std::memory_order_relaxed) + 1;
+    consecutiveDeadlineMisses.store(consecutive, std::memory_order_relaxed);
+    deadlineMisses.store(deadlineMisses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if( consecutive > maxConsecutiveDeadlineMisses.load(std::memory_order_relaxed) )
+    {
+        maxConsecutiveDeadlineMisses.store(consecutive, std::memory_order_relaxed);
+    }
+    const uint32_t overrun32 = (overrunUs > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(overrunUs);
+    if( overrun32 > worstDeadlineOverrunUs.load(std::memory_order_relaxed) )
+    {
+        worstDeadlineOverrunUs.store(overrun32, std::memory_order_relaxed);
+    }
+
+    DeadlineMiss miss;
+    miss.stepUs = (stepUs > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(stepUs);
+    miss.intervalUs = (intervalUs > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(intervalUs);
+    miss.overrunUs = overrun32;
+    miss.consecutiveMisses = consecutive;
+    OnDeadlineMiss(miss);
+}
+
+bool BaseThread::SetStepBudget(uint32_t budgetUs, uint32_t periodUs) noexcept
+{
+    if( IsThreadRunning() )
+    {
+        return false;
+    }
+    stepBudgetUs = budgetUs;
+    stepPeriodUs = periodUs;
+    return true;
+}
+
+BaseThread::DeadlineStats BaseThread::GetDeadlineStats() const noexcept
+{
+    DeadlineStats stats;
+    stats.misses = deadlineMisses.load(std::memory_order_relaxed);
+    stats.consecutiveMisses = consecutiveDeadlineMisses.load(std::memory_order_relaxed);
+    stats.maxConsecutiveMisses = maxConsecutiveDeadlineMisses.load(std::memory_order_relaxed);
+    stats.worstOverrunUs = worstDeadlineOverrunUs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void BaseThread::ResetDeadlineStats() noexcept
+{
+    deadlineMisses.store(0, std::memory_order_relaxed);
+    consecutiveDeadlineMisses.store(0, std::memory_order_relaxed);
+    maxConsecutiveDeadlineMisses.store(0, std::memory_order_relaxed);
+    worstDeadlineOverrunUs.store(0, std::memory_order_relaxed);
+}
+
+#if defined(HF_BASETHREAD_STEP_STATS)
+void BaseThread::StepStatsBegin(uint64_t stepStartUs) noexcept
+{
+    if( expectedStepStartUs != 0 )
+    {
+        const uint64_t lateUs = (stepStartUs > expectedStepStartUs) ? (stepStartUs - expectedStepStartUs) : 0;
+        startJitterHistogram.Record(lateUs > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(lateUs));
+    }
+}
+
+void BaseThread::StepStatsEnd(uint64_t stepStartUs, uint64_t stepEndUs) noexcept
+{
+    const uint64_t stepUs = stepEndUs - stepStartUs;
+    stepTimeHistogram.Record(stepUs > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(stepUs));
+
+    /// FixedRate releases steps a period apart; Delay mode sleeps after the step.
+    /// EventDriven steps start whenever work arrives, so there is no expected start.
+    const uint64_t requestedUs = static_cast<uint64_t>(waitBeforeStep) * 1000ULL;
+    if( scheduleMode == ScheduleMode::EventDriven )
+    {
+        expectedStepStartUs = 0;
+    }
+    else
+    {
+        expectedStepStartUs = ((scheduleMode == ScheduleMode::FixedRate) ? stepStartUs : stepEndUs) + requestedUs;
+    }
+}
+#endif
+
+bool BaseThread::SetScheduleMode(ScheduleMode mode, OverrunPolicy policy) noexcept
+{
+    if( IsThreadRunning() )
+    {
+        return false;
+    }
+    scheduleMode = mode;
+    overrunPolicy = policy;
+    return true;
+}
+
 /**
  * @brief Puts the caller thread in a waiting state until the service_start() is called.
  *
@@ -262,52 +546,135 @@ void BaseThread::WaitForStart() noexcept
 }
 
 bool BaseThread::StartThreadAndWaitToVerify(uint32_t startTimeoutMsec) {
-    /// Start the thread
+    /// Start the thread and block until it reports running
     if (Start()) {
-        /// Function that will test if the thread has been started
-        std::function<bool()> CheckIfThreadIsStarted = [this]() {
-            return IsThreadRunning();
-        };
-
-        /// Expecting true within the timeout specified
-        bool result = TestLogicWithTimeout(CheckIfThreadIsStarted, true, startTimeoutMsec, 10);
-
-        return result; /// Return result
+        return WaitUntilRunning(startTimeoutMsec);
     }
 
     return false; /// Return false indicating Start() call failure
 }
 
 bool BaseThread::StopThreadAndWaitToVerify(uint32_t stopTimeoutMsec) {
-    /// Stop the thread
+    /// Stop the thread and block until it reports stopped
     if (Stop())
     {
-        /// Function that will test if the thread has been stopped
-        std::function<bool()> CheckIfThreadIsStopped = [this]() {
-            return IsThreadStopped();
-        };
+        return WaitUntilStopped(stopTimeoutMsec);
+    }
+
+    return false; /// Return false indicating Stop() call failure
+}
+
+bool BaseThread::WaitUntilRunning(uint32_t timeoutMsec) noexcept
+{
+    return WaitForRunState(kThreadRunningBit, timeoutMsec);
+}
+
+bool BaseThread::WaitUntilStopped(uint32_t timeoutMsec) noexcept
+{
+    return WaitForRunState(kThreadStoppedBit, timeoutMsec);
+}
 
-        /// Expecting true within the timeout specified
-        bool result = TestLogicWithTimeout(CheckIfThreadIsStopped, true, stopTimeoutMsec, 10);
+bool BaseThread::WaitUntilReady(uint32_t timeoutMsec) noexcept
+{
+    return WaitForRunState(kThreadReadyBit, timeoutMsec);
+}
 
-        return result; /// Return result
+void BaseThread::PublishRunState(bool running) noexcept
+{
+    if( !threadEventsCreated )
+    {
+        return;
     }
+    /// Clear the old state before setting the new one so a waiter never sees both.
+    (void)os_event_flags_clear_ex( threadEvents, running ? kThreadStoppedBit : kThreadRunningBit );
+    (void)os_event_flags_set_ex( threadEvents, running ? kThreadRunningBit : kThreadStoppedBit );
+}
 
-    return false; /// Return false indicating Stop() call failure
+void BaseThread::PublishReadyState(bool ready) noexcept
+{
+    if( !threadEventsCreated )
+    {
+        return;
+    }
+    if( ready )
+    {
+        (void)os_event_flags_set_ex( threadEvents, kThreadReadyBit );
+    }
+    else
+    {
+        (void)os_event_flags_clear_ex( threadEvents, kThreadReadyBit );
+    }
+}
+
+bool BaseThread::WaitForRunState(OS_Ulong stateBit, uint32_t timeoutMsec) noexcept
+{
+    if( !threadEventsCreated )
+    {
+        if( stateBit == kThreadReadyBit )
+        {
+            return IsThreadRunning() && IsSetupComplete();
+        }
+        return (stateBit == kThreadRunningBit) ? IsThreadRunning() : IsThreadStopped();
+    }
+
+    OS_Ulong ticks = static_cast<OS_Ulong>(OS_WAIT_FOREVER);
+    if( timeoutMsec != UINT32_MAX )
+    {
+        ticks = os_convert_msec_to_delay_ticks(timeoutMsec);
+        if( ticks == 0 && timeoutMsec != 0 )
+        {
+            ticks = 1;  /// Never round a non-zero timeout down to a poll.
+        }
+    }
+
+    /// Waiting for any of a single bit leaves it set for other waiters.
+    OS_Ulong actual = 0;
+    (void)os_event_flags_get_ex( threadEvents, stateBit, OS_OR, actual, ticks );
+    return (actual & stateBit) != 0;
 }
 
+bool BaseThread::SetCoreAffinity(int core) noexcept
+{
+    if( core >= os_get_core_count() )
+    {
+        return false;
+    }
+    if( !osThreadCreated )
+    {
+        requestedCoreId = (core < 0) ? -1 : core;
+        return true;
+    }
+    if( os_thread_affinity_set( &osThread, core ) != OS_SUCCESS )
+    {
+        return false;
+    }
+    threadCoreId.store( (core < 0) ? -1 : core, std::memory_order_relaxed );
+    return true;
+}
 
+bool BaseThread::SampleCpuUsage(uint32_t nowUs) noexcept
+{
+    uint32_t busyUs = 0;
+    if( !osThreadCreated || os_thread_cpu_time_get( &osThread, &busyUs ) != OS_SUCCESS )
+    {
+        return false;
+    }
+    cpuUsage.Sample( busyUs, nowUs );
+    return true;
+}
 
 uint32_t BaseThread::GetStackHighWaterMark() const noexcept
 {
-    return uxTaskGetStackHighWaterMark(osThread);
+    return static_cast<uint32_t>(os_thread_stack_high_water_mark(&osThread));
 }
 
 bool BaseThread::ChangePriority(uint32_t newPriority) noexcept
 {
     if (osThread) {
-        vTaskPrioritySet(osThread, newPriority);
-        return true;
+        if (os_thread_priority_set(&osThread, newPriority) == OS_SUCCESS) {
+            threadPriority.store(newPriority, std::memory_order_relaxed);
+            return true;
+        }
     }
     return false;
 }
@@ -1,3 +1,5 @@
 #include "OsAbstraction.h"
 
+#if defined(HF_RTOS_FREERTOS)
 OS_Critical os_critical_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
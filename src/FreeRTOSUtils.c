@@ -7,6 +7,8 @@
 
 #include "FreeRTOSUtils.h"
 
+#if defined(HF_RTOS_FREERTOS)
+
 const char* freertos_ret_to_string(BaseType_t result) {
     switch (result) {
         case pdPASS:
@@ -48,3 +50,5 @@ const char* freertos_task_state_to_string(eTaskState state) {
             return "Unknown state";
     }
 }
+
+#endif /* HF_RTOS_FREERTOS */
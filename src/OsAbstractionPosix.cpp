@@ -0,0 +1,1368 @@
+/**
+ * @file OsAbstractionPosix.cpp
+ * @brief POSIX (pthreads) implementation of the OsAbstraction.h primitives.
+ *
+ * Compiled only when `HF_RTOS_POSIX` is defined. Lets the C++ wrappers
+ * (`OsQueue`, `SeqlockSnapshot`, `BaseThread`, `RtosSharedMutex`, ...) run
+ * with real concurrency on Linux build hosts for load tests and profiling.
+ *
+ * Design notes:
+ *   - One tick is one millisecond; all timed waits use CLOCK_MONOTONIC.
+ *   - Every blocking call registers the object it waits on in the calling
+ *     thread's control block so that `os_thread_delete` can wake it. A
+ *     deleted thread is parked forever (it cannot be unwound through the
+ *     `noexcept` C++ frames above it) and never touches the object again.
+ *   - Suspension is cooperative: a suspended thread stops at its next
+ *     blocking os_* call. Self-suspension is immediate.
+ *   - Timers are serviced by a single lazily-started daemon thread, like
+ *     the FreeRTOS timer service task.
+ *
+ * @todo Add @copyright line once project copyright wording is finalised.
+ */
+
+#if defined(HF_RTOS_POSIX)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sched.h>
+#include <unistd.h>
+
+#include "OsAbstraction.h"
+
+//==============================================================//
+// GLOBALS
+//==============================================================//
+
+// Critical section mutex required by OsAbstraction.h
+OS_Critical os_critical_mux;
+
+namespace {
+
+/// Minimum stack handed to pthreads; target stack sizes are far too small
+/// for host builds (libc, sanitizers).
+constexpr size_t kMinHostStackBytes = 64U * 1024U;
+
+constexpr uint64_t kNsPerTick = 1000000ULL;
+
+thread_local os_posix_thread_t* tls_self = nullptr;
+
+pthread_once_t g_init_once = PTHREAD_ONCE_INIT;
+
+//==============================================================//
+// CLOCK HELPERS
+//==============================================================//
+
+uint64_t MonotonicNs() noexcept
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/// CLOCK_MONOTONIC reading that os_time_get / os_time_get_ns count from.
+uint64_t EpochNs() noexcept
+{
+    static const uint64_t epoch_ns = MonotonicNs();
+    return epoch_ns;
+}
+
+timespec NsToTimespec(uint64_t ns) noexcept
+{
+    timespec ts;
+    ts.tv_sec  = static_cast<time_t>(ns / 1000000000ULL);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000ULL);
+    return ts;
+}
+
+/// Absolute deadline for a tick timeout; nullptr means "wait forever".
+const timespec* MakeDeadline(OS_Ulong wait, timespec& storage) noexcept
+{
+    if (wait == static_cast<OS_Ulong>(OS_WAIT_FOREVER)) {
+        return nullptr;
+    }
+    storage = NsToTimespec(MonotonicNs() + static_cast<uint64_t>(wait) * kNsPerTick);
+    return &storage;
+}
+
+void InitCond(pthread_cond_t* c) noexcept
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(c, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+//==============================================================//
+// THREAD CONTROL BLOCK HELPERS
+//==============================================================//
+
+/// Never returns: the calling thread has been deleted.
+[[noreturn]] void Park(os_posix_thread_t* self) noexcept
+{
+    pthread_mutex_lock(&self->lock);
+    self->parked     = 1;
+    self->wait_cond  = nullptr;
+    self->wait_mutex = nullptr;
+    pthread_cond_broadcast(&self->cond);
+    for (;;) {
+        pthread_cond_wait(&self->cond, &self->lock);
+    }
+}
+
+/**
+ * @brief Wait on the calling thread's own condition variable until
+ *        @p deadline, honouring suspend and delete requests.
+ *
+ * Called with self->lock held; returns with it held.
+ */
+int SelfWait(os_posix_thread_t* self, const timespec* deadline) noexcept
+{
+    self->wait_cond  = &self->cond;
+    self->wait_mutex = &self->lock;
+    const int rc = deadline ? pthread_cond_timedwait(&self->cond, &self->lock, deadline)
+                            : pthread_cond_wait(&self->cond, &self->lock);
+    if (self->delete_requested) {
+        pthread_mutex_unlock(&self->lock);
+        Park(self);
+    }
+    self->wait_cond  = nullptr;
+    self->wait_mutex = nullptr;
+    return rc;
+}
+
+/**
+ * @brief Blocking-call entry point: stop here while suspended, park if
+ *        deleted. No-op for threads not created through os_thread_create.
+ */
+void Checkpoint() noexcept
+{
+    os_posix_thread_t* self = tls_self;
+    if (self == nullptr) return;
+    pthread_mutex_lock(&self->lock);
+    while (self->suspended && !self->delete_requested) {
+        (void)SelfWait(self, nullptr);
+    }
+    if (self->delete_requested) {
+        pthread_mutex_unlock(&self->lock);
+        Park(self);
+    }
+    pthread_mutex_unlock(&self->lock);
+}
+
+/**
+ * @brief Sleep until the absolute CLOCK_MONOTONIC @p deadline, honouring
+ *        suspend and delete requests for os_thread_create threads.
+ */
+void SleepUntil(const timespec& deadline) noexcept
+{
+    os_posix_thread_t* self = tls_self;
+    if (self == nullptr) {
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+        }
+        return;
+    }
+    Checkpoint();
+    pthread_mutex_lock(&self->lock);
+    while (SelfWait(self, &deadline) != ETIMEDOUT || self->suspended) {
+        if (self->suspended) {
+            (void)SelfWait(self, nullptr);
+        }
+    }
+    pthread_mutex_unlock(&self->lock);
+}
+
+/**
+ * @brief Wait on an object's condition variable. Called with @p m held;
+ *        returns with it held (unless the thread is deleted meanwhile).
+ * @return 0 when woken, ETIMEDOUT when @p deadline passed.
+ */
+int ObjectWait(pthread_cond_t* c, pthread_mutex_t* m, const timespec* deadline) noexcept
+{
+    os_posix_thread_t* self = tls_self;
+    if (self != nullptr) {
+        pthread_mutex_lock(&self->lock);
+        if (self->delete_requested) {
+            pthread_mutex_unlock(&self->lock);
+            pthread_mutex_unlock(m);
+            Park(self);
+        }
+        self->wait_cond  = c;
+        self->wait_mutex = m;
+        pthread_mutex_unlock(&self->lock);
+    }
+
+    const int rc = deadline ? pthread_cond_timedwait(c, m, deadline) : pthread_cond_wait(c, m);
+
+    if (self != nullptr) {
+        pthread_mutex_lock(&self->lock);
+        const int deleted = self->delete_requested;
+        if (!deleted) {
+            self->wait_cond  = nullptr;
+            self->wait_mutex = nullptr;
+        }
+        pthread_mutex_unlock(&self->lock);
+        if (deleted) {
+            pthread_mutex_unlock(m);
+            Park(self);
+        }
+    }
+    return rc;
+}
+
+void* ThreadTrampoline(void* p)
+{
+    os_posix_thread_t* self = static_cast<os_posix_thread_t*>(p);
+    tls_self = self;
+    Checkpoint();  // holds here until resumed when created with OS_DONT_START
+    self->entry(self->arg);
+
+    pthread_mutex_lock(&self->lock);
+    self->exited = 1;
+    pthread_cond_broadcast(&self->cond);
+    pthread_mutex_unlock(&self->lock);
+    return nullptr;
+}
+
+//==============================================================//
+// TIMER SERVICE
+//==============================================================//
+
+struct TimerService {
+    pthread_mutex_t   lock;
+    pthread_cond_t    cond;
+    pthread_cond_t    done;
+    pthread_t         tid;
+    os_posix_timer_t* head;
+    os_posix_timer_t* running;
+    bool              started;
+};
+
+TimerService g_timers;
+
+void GlobalInit() noexcept
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&os_critical_mux, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    pthread_mutex_init(&g_timers.lock, nullptr);
+    InitCond(&g_timers.cond);
+    InitCond(&g_timers.done);
+    g_timers.head    = nullptr;
+    g_timers.running = nullptr;
+    g_timers.started = false;
+}
+
+void EnsureGlobals() noexcept
+{
+    pthread_once(&g_init_once, GlobalInit);
+}
+
+void TimerUnlink(os_posix_timer_t* t) noexcept
+{
+    if (!t->linked) return;
+    for (os_posix_timer_t** pp = &g_timers.head; *pp != nullptr; pp = &(*pp)->next) {
+        if (*pp == t) {
+            *pp = t->next;
+            break;
+        }
+    }
+    t->next   = nullptr;
+    t->linked = 0;
+}
+
+void* TimerDaemon(void*)
+{
+    pthread_mutex_lock(&g_timers.lock);
+    for (;;) {
+        os_posix_timer_t* due = nullptr;
+        for (os_posix_timer_t* t = g_timers.head; t != nullptr; t = t->next) {
+            if (due == nullptr || t->expiry_ns < due->expiry_ns) {
+                due = t;
+            }
+        }
+        if (due == nullptr) {
+            pthread_cond_wait(&g_timers.cond, &g_timers.lock);
+            continue;
+        }
+        const uint64_t now = MonotonicNs();
+        if (due->expiry_ns > now) {
+            const timespec deadline = NsToTimespec(due->expiry_ns);
+            pthread_cond_timedwait(&g_timers.cond, &g_timers.lock, &deadline);
+            continue;
+        }
+
+        // Re-arm (or retire) before the callback so the daemon never touches
+        // the control block after the callback; it may delete its own timer.
+        if (due->auto_reload) {
+            due->expiry_ns += static_cast<uint64_t>(due->period) * kNsPerTick;
+            if (due->expiry_ns <= now) {
+                due->expiry_ns = now + static_cast<uint64_t>(due->period) * kNsPerTick;
+            }
+        } else {
+            TimerUnlink(due);
+        }
+        void (*cb)(uint32_t) = due->cb;
+        const OS_Ulong id    = due->id;
+        g_timers.running     = due;
+        pthread_mutex_unlock(&g_timers.lock);
+
+        cb(static_cast<uint32_t>(id));
+
+        pthread_mutex_lock(&g_timers.lock);
+        g_timers.running = nullptr;
+        pthread_cond_broadcast(&g_timers.done);
+    }
+    return nullptr;
+}
+
+/// Called with g_timers.lock held.
+bool EnsureTimerDaemon() noexcept
+{
+    if (g_timers.started) return true;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    g_timers.started = (pthread_create(&g_timers.tid, &attr, TimerDaemon, nullptr) == 0);
+    pthread_attr_destroy(&attr);
+    return g_timers.started;
+}
+
+//==============================================================//
+// SHARED CREATION HELPERS
+//==============================================================//
+
+OS_Uint MutexInit(OS_Mutex* m, os_posix_mutex_t* mx, int recursive, int static_storage) noexcept
+{
+    if (m == nullptr || mx == nullptr) return 1;
+    std::memset(mx, 0, sizeof(*mx));
+    pthread_mutex_init(&mx->lock, nullptr);
+    InitCond(&mx->cond);
+    mx->recursive      = recursive;
+    mx->static_storage = static_storage;
+    *m = mx;
+    return OS_SUCCESS;
+}
+
+OS_Uint MutexCreate(OS_Mutex* m, int recursive) noexcept
+{
+    os_posix_mutex_t* mx = static_cast<os_posix_mutex_t*>(std::calloc(1, sizeof(os_posix_mutex_t)));
+    if (mx == nullptr) return 1;
+    const OS_Uint status = MutexInit(m, mx, recursive, 0);
+    if (status != OS_SUCCESS) std::free(mx);
+    return status;
+}
+
+OS_Uint MutexGet(OS_Mutex* m, OS_Ulong wait) noexcept
+{
+    if (m == nullptr || *m == nullptr) return 1;
+    Checkpoint();
+    os_posix_mutex_t* mx = *m;
+    const pthread_t me   = pthread_self();
+    timespec storage;
+    const timespec* deadline = MakeDeadline(wait, storage);
+
+    pthread_mutex_lock(&mx->lock);
+    if (mx->count > 0U && pthread_equal(mx->owner, me) && mx->recursive) {
+        ++mx->count;
+        pthread_mutex_unlock(&mx->lock);
+        return OS_SUCCESS;
+    }
+    int rc = 0;
+    while (mx->count > 0U && rc != ETIMEDOUT && wait != OS_NO_WAIT) {
+        rc = ObjectWait(&mx->cond, &mx->lock, deadline);
+    }
+    OS_Uint status = 1;
+    if (mx->count == 0U) {
+        mx->owner = me;
+        mx->count = 1U;
+        status    = OS_SUCCESS;
+    }
+    pthread_mutex_unlock(&mx->lock);
+    return status;
+}
+
+OS_Uint MutexPut(OS_Mutex* m) noexcept
+{
+    if (m == nullptr || *m == nullptr) return 1;
+    os_posix_mutex_t* mx = *m;
+    OS_Uint status = 1;
+    pthread_mutex_lock(&mx->lock);
+    if (mx->count > 0U && pthread_equal(mx->owner, pthread_self())) {
+        if (--mx->count == 0U) {
+            pthread_cond_signal(&mx->cond);
+        }
+        status = OS_SUCCESS;
+    }
+    pthread_mutex_unlock(&mx->lock);
+    return status;
+}
+
+OS_Uint MutexDelete(OS_Mutex* m) noexcept
+{
+    if (m == nullptr || *m == nullptr) return 1;
+    pthread_cond_destroy(&(*m)->cond);
+    pthread_mutex_destroy(&(*m)->lock);
+    if (!(*m)->static_storage) std::free(*m);
+    *m = nullptr;
+    return OS_SUCCESS;
+}
+
+void SemaphoreInit(os_posix_semaphore_t* sem, OS_Uint initial, int static_storage) noexcept
+{
+    std::memset(sem, 0, sizeof(*sem));
+    pthread_mutex_init(&sem->lock, nullptr);
+    InitCond(&sem->cond);
+    sem->count          = initial;
+    sem->max_count      = UINT16_MAX;
+    sem->static_storage = static_storage;
+}
+
+void EventGroupInit(os_posix_event_group_t* group, int static_storage) noexcept
+{
+    std::memset(group, 0, sizeof(*group));
+    pthread_mutex_init(&group->lock, nullptr);
+    InitCond(&group->cond);
+    group->static_storage = static_storage;
+}
+
+void TimerInit(os_posix_timer_t* timer, void (*cb)(uint32_t), OS_Ulong id,
+               OS_Ulong initial, OS_Ulong reload, int static_storage) noexcept
+{
+    std::memset(timer, 0, sizeof(*timer));
+    timer->cb             = cb;
+    timer->id             = id;
+    timer->period         = initial;
+    timer->auto_reload    = (reload != 0U) ? 1 : 0;
+    timer->static_storage = static_storage;
+}
+
+OS_Uint ThreadCreate(OS_Thread* t, const char* name, void (*entry)(OS_Ulong),
+                     OS_Ulong input, OS_Ulong stack_size, OS_Uint priority,
+                     OS_Uint auto_start, int core_id) noexcept
+{
+    if (t == nullptr || entry == nullptr) return 1;
+    os_posix_thread_t* th = static_cast<os_posix_thread_t*>(std::calloc(1, sizeof(os_posix_thread_t)));
+    if (th == nullptr) return 1;
+
+    pthread_mutex_init(&th->lock, nullptr);
+    InitCond(&th->cond);
+    th->entry      = entry;
+    th->arg        = input;
+    th->stack_size = stack_size;
+    th->priority   = priority;
+    // Pinning to a core the host does not have would fail pthread_create;
+    // run unpinned instead, as os_thread_affinity_set refuses such cores.
+    th->core_id    = (core_id < os_get_core_count()) ? core_id : -1;
+    th->suspended  = auto_start ? 0 : 1;
+    if (name != nullptr) {
+        std::strncpy(th->name, name, sizeof(th->name) - 1U);
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_attr_setstacksize(&attr, (stack_size > kMinHostStackBytes) ? stack_size : kMinHostStackBytes);
+#if defined(__linux__)
+    if (th->core_id >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(th->core_id, &set);
+        pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+    }
+#endif
+
+    *t = th;
+    const int rc = pthread_create(&th->tid, &attr, ThreadTrampoline, th);
+    pthread_attr_destroy(&attr);
+    if (rc != 0) {
+        *t = nullptr;
+        pthread_cond_destroy(&th->cond);
+        pthread_mutex_destroy(&th->lock);
+        std::free(th);
+        return 1;
+    }
+#if defined(__linux__)
+    pthread_setname_np(th->tid, th->name);
+#endif
+    return OS_SUCCESS;
+}
+
+}  // namespace
+
+//==============================================================//
+// TIME
+//==============================================================//
+
+OS_Ulong os_time_get(void)
+{
+    return static_cast<OS_Ulong>(os_time_get_ns() / kNsPerTick);
+}
+
+uint64_t os_time_get_ns(void)
+{
+    const uint64_t epoch_ns = EpochNs();
+    return MonotonicNs() - epoch_ns;
+}
+
+uint64_t os_time_get_us(void)
+{
+    return os_time_get_ns() / 1000U;
+}
+
+//==============================================================//
+// THREAD
+//==============================================================//
+
+OS_Uint os_thread_create(OS_Thread *t, const char *name, void (*entry)(OS_Ulong),
+                         OS_Ulong input, uint8_t * /*stack*/, OS_Ulong stack_size,
+                         OS_Uint priority, OS_Uint /*preempt*/, OS_Ulong /*slice*/,
+                         OS_Uint auto_start)
+{
+    return ThreadCreate(t, name, entry, input, stack_size, priority, auto_start, -1);
+}
+
+OS_Uint os_thread_create_pinned(OS_Thread *t, const char *name, void (*entry)(OS_Ulong),
+                                OS_Ulong input, uint8_t * /*stack*/, OS_Ulong stack_size,
+                                OS_Uint priority, OS_Uint /*preempt*/, OS_Ulong /*slice*/,
+                                OS_Uint auto_start, int core_id)
+{
+    return ThreadCreate(t, name, entry, input, stack_size, priority, auto_start, core_id);
+}
+
+// The control block carries entry/arg itself; ctx is filled for symmetry
+// with the FreeRTOS backend, which runs the task off it.
+OS_Uint os_thread_create_ctx(OS_Thread *t, os_thread_start_t *ctx, const char *name,
+                             void (*entry)(OS_Ulong), OS_Ulong input, uint8_t * /*stack*/,
+                             OS_Ulong stack_size, OS_Uint priority, OS_Uint /*preempt*/,
+                             OS_Ulong /*slice*/, OS_Uint auto_start, int core_id)
+{
+    if (ctx == nullptr) return 1;
+    ctx->entry = entry;
+    ctx->arg   = input;
+    return ThreadCreate(t, name, entry, input, stack_size, priority, auto_start, core_id);
+}
+
+int os_get_current_core_id(void)
+{
+#if defined(__linux__)
+    const int cpu = sched_getcpu();
+    return (cpu < 0) ? 0 : cpu;
+#else
+    return 0;
+#endif
+}
+
+int os_get_core_count(void)
+{
+    const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cores < 1) ? 1 : static_cast<int>(cores);
+}
+
+OS_Uint os_thread_resume(OS_Thread *t)
+{
+    if (t == nullptr || *t == nullptr) return 1;
+    os_posix_thread_t* th = *t;
+    pthread_mutex_lock(&th->lock);
+    th->suspended = 0;
+    pthread_cond_broadcast(&th->cond);
+    pthread_mutex_unlock(&th->lock);
+    return OS_SUCCESS;
+}
+
+OS_Uint os_thread_suspend(OS_Thread *t)
+{
+    if (t == nullptr || *t == nullptr) return 1;
+    os_posix_thread_t* th = *t;
+    pthread_mutex_lock(&th->lock);
+    th->suspended = 1;
+    pthread_mutex_unlock(&th->lock);
+    if (th == tls_self) {
+        Checkpoint();
+    }
+    return OS_SUCCESS;
+}
+
+OS_Uint os_thread_delete(OS_Thread *t)
+{
+    if (t == nullptr || *t == nullptr) return 1;
+    os_posix_thread_t* th = *t;
+    if (th == tls_self) {
+        Park(th);
+    }
+
+    pthread_mutex_lock(&th->lock);
+    th->delete_requested = 1;
+    pthread_cond_broadcast(&th->cond);
+
+    // Wake the thread out of whatever object it is blocked on. th->lock stays
+    // held so the thread cannot leave the wait (and the object cannot be
+    // released) before the broadcast; ObjectWait takes the object mutex
+    // before th->lock, so only try it here and back off on contention.
+    while (th->wait_cond != nullptr && th->wait_cond != &th->cond) {
+        if (pthread_mutex_trylock(th->wait_mutex) == 0) {
+            pthread_cond_broadcast(th->wait_cond);
+            pthread_mutex_unlock(th->wait_mutex);
+            break;
+        }
+        pthread_mutex_unlock(&th->lock);
+        sched_yield();
+        pthread_mutex_lock(&th->lock);
+    }
+
+    // Wait until it has parked at its next blocking call (or exited), so it
+    // never touches its objects again once the caller destroys them, as
+    // after vTaskDelete. A thread busy outside os_* calls may not get there
+    // for a long time; give up after HF_RTOS_POSIX_DELETE_WAIT_MS.
+    timespec storage;
+    const timespec* deadline = MakeDeadline(static_cast<OS_Ulong>(HF_RTOS_POSIX_DELETE_WAIT_MS), storage);
+    int rc = 0;
+    while (!th->parked && !th->exited && rc != ETIMEDOUT) {
+        rc = pthread_cond_timedwait(&th->cond, &th->lock, deadline);
+    }
+    const bool exited = (th->exited != 0);
+    const bool parked = (th->parked != 0);
+    pthread_mutex_unlock(&th->lock);
+
+    if (exited) {
+        pthread_cond_destroy(&th->cond);
+        pthread_mutex_destroy(&th->lock);
+        std::free(th);
+        return OS_SUCCESS;
+    }
+    // A parked or still-running thread keeps its control block for life.
+    return parked ? OS_SUCCESS : 1U;
+}
+
+OS_Uint os_thread_terminate(OS_Thread *t)
+{
+    return os_thread_delete(t);
+}
+
+OS_Uint os_thread_info_get(OS_Thread *t, OS_Uint *state)
+{
+    if (t == nullptr || *t == nullptr) return 1;
+    os_posix_thread_t* th = *t;
+    if (state != nullptr) {
+        pthread_mutex_lock(&th->lock);
+        if (th->parked || th->exited || th->delete_requested) {
+            *state = OS_THREAD_DELETED;
+        } else if (th->suspended) {
+            *state = OS_THREAD_SUSPENDED;
+        } else if (th->wait_cond != nullptr) {
+            *state = OS_THREAD_BLOCKED;
+        } else if (th == tls_self) {
+            *state = OS_THREAD_RUNNING;
+        } else {
+            *state = OS_THREAD_READY;
+        }
+        pthread_mutex_unlock(&th->lock);
+    }
+    return OS_SUCCESS;
+}
+
+OS_Uint os_thread_sleep(OS_Ulong ticks)
+{
+    if (ticks == 0U) {
+        Checkpoint();
+        sched_yield();
+        return OS_SUCCESS;
+    }
+    SleepUntil(NsToTimespec(MonotonicNs() + static_cast<uint64_t>(ticks) * kNsPerTick));
+    return OS_SUCCESS;
+}
+
+OS_Ulong os_thread_stack_high_water_mark(const OS_Thread *t)
+{
+    // Host stacks are never the constraint; report the requested size in
+    // words so callers comparing against a budget see full headroom.
+    if (t == nullptr || *t == nullptr) return 0;
+    return (*t)->stack_size / sizeof(uintptr_t);
+}
+
+OS_Uint os_thread_priority_set(OS_Thread *t, OS_Uint priority)
+{
+    if (t == nullptr || *t == nullptr) return 1;
+    pthread_mutex_lock(&(*t)->lock);
+    (*t)->priority = priority;
+    pthread_mutex_unlock(&(*t)->lock);
+    return OS_SUCCESS;
+}
+
+OS_Uint os_thread_affinity_set(OS_Thread *t, int core_id)
+{
+    if (t == nullptr || *t == nullptr || core_id >= os_get_core_count()) return 1;
+    os_posix_thread_t* th = *t;
+    pthread_mutex_lock(&th->lock);
+    int rc = th->exited ? 1 : 0;
+#if defined(__linux__)
+    if (rc == 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (core_id < 0) {
+            for (int cpu = 0; cpu < os_get_core_count(); ++cpu) CPU_SET(cpu, &set);
+        } else {
+            CPU_SET(core_id, &set);
+        }
+        rc = pthread_setaffinity_np(th->tid, sizeof(set), &set);
+    }
+#endif
+    if (rc == 0) th->core_id = core_id;
+    pthread_mutex_unlock(&th->lock);
+    if (rc != 0) return 1;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_thread_cpu_time_get(const OS_Thread *t, uint32_t *us)
+{
+    *us = 0;
+    if (t == nullptr || *t == nullptr) return 1;
+    os_posix_thread_t* th = *t;
+    clockid_t clock;
+    pthread_mutex_lock(&th->lock);
+    const bool ok = !th->exited && pthread_getcpuclockid(th->tid, &clock) == 0;
+    pthread_mutex_unlock(&th->lock);
+    if (!ok) return 1;
+    timespec ts;
+    if (clock_gettime(clock, &ts) != 0) return 1;
+    const uint64_t ns = static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    *us = static_cast<uint32_t>(ns / 1000U);
+    return OS_SUCCESS;
+}
+
+OS_Uint os_core_idle_time_get(int core, uint32_t *us)
+{
+    (void)core;
+    *us = 0;
+    return 1;
+}
+
+//==============================================================//
+// TASK NOTIFICATION
+//==============================================================//
+
+OS_Thread os_thread_self(void)
+{
+    return tls_self;
+}
+
+OS_Uint os_thread_notify_give(OS_Thread *t)
+{
+    if (t == nullptr || *t == nullptr) return 1;
+    os_posix_thread_t* th = *t;
+    pthread_mutex_lock(&th->lock);
+    ++th->notify_count;
+    pthread_cond_broadcast(&th->cond);
+    pthread_mutex_unlock(&th->lock);
+    return OS_SUCCESS;
+}
+
+OS_Uint os_thread_notify_take(OS_Ulong wait)
+{
+    os_posix_thread_t* self = tls_self;
+    if (self == nullptr) return 1;
+    Checkpoint();
+    timespec storage;
+    const timespec* deadline = MakeDeadline(wait, storage);
+
+    pthread_mutex_lock(&self->lock);
+    int rc = 0;
+    while ((self->notify_count == 0U && rc != ETIMEDOUT && wait != OS_NO_WAIT) || self->suspended) {
+        rc = SelfWait(self, self->suspended ? nullptr : deadline);
+    }
+    OS_Uint status = 1;
+    if (self->notify_count > 0U) {
+        --self->notify_count;
+        status = OS_SUCCESS;
+    }
+    pthread_mutex_unlock(&self->lock);
+    return status;
+}
+
+OS_Ulong os_thread_notify_peek(OS_Thread *t)
+{
+    if (t == nullptr || *t == nullptr) return 0;
+    pthread_mutex_lock(&(*t)->lock);
+    const OS_Ulong count = (*t)->notify_count;
+    pthread_mutex_unlock(&(*t)->lock);
+    return count;
+}
+
+//==============================================================//
+// MUTEX
+//==============================================================//
+
+OS_Uint os_mutex_create(OS_Mutex *m, const char * /*name*/, OS_Uint /*inherit*/) { return MutexCreate(m, 0); }
+OS_Uint os_mutex_get(OS_Mutex *m, OS_Ulong wait)                                 { return MutexGet(m, wait); }
+OS_Uint os_mutex_put(OS_Mutex *m)                                                { return MutexPut(m); }
+OS_Uint os_mutex_delete(OS_Mutex *m)                                             { return MutexDelete(m); }
+
+OS_Uint os_recursive_mutex_create(OS_Mutex *m, const char * /*name*/) { return MutexCreate(m, 1); }
+OS_Uint os_recursive_mutex_get(OS_Mutex *m, OS_Ulong wait)           { return MutexGet(m, wait); }
+OS_Uint os_recursive_mutex_put(OS_Mutex *m)                          { return MutexPut(m); }
+OS_Uint os_recursive_mutex_delete(OS_Mutex *m)                       { return MutexDelete(m); }
+
+//==============================================================//
+// SEMAPHORE
+//==============================================================//
+
+OS_Uint os_semaphore_create(OS_Semaphore *s, const char * /*name*/, OS_Uint initial)
+{
+    if (s == nullptr) return 1;
+    os_posix_semaphore_t* sem = static_cast<os_posix_semaphore_t*>(std::calloc(1, sizeof(os_posix_semaphore_t)));
+    if (sem == nullptr) return 1;
+    SemaphoreInit(sem, initial, 0);
+    *s = sem;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_semaphore_delete(OS_Semaphore *s)
+{
+    if (s == nullptr || *s == nullptr) return 1;
+    pthread_cond_destroy(&(*s)->cond);
+    pthread_mutex_destroy(&(*s)->lock);
+    if (!(*s)->static_storage) std::free(*s);
+    *s = nullptr;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_semaphore_put(OS_Semaphore *s)
+{
+    if (s == nullptr || *s == nullptr) return 1;
+    os_posix_semaphore_t* sem = *s;
+    OS_Uint status = 1;
+    pthread_mutex_lock(&sem->lock);
+    if (sem->count < sem->max_count) {
+        ++sem->count;
+        pthread_cond_signal(&sem->cond);
+        status = OS_SUCCESS;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return status;
+}
+
+OS_Uint os_semaphore_get(OS_Semaphore *s, OS_Ulong wait)
+{
+    if (s == nullptr || *s == nullptr) return 1;
+    Checkpoint();
+    os_posix_semaphore_t* sem = *s;
+    timespec storage;
+    const timespec* deadline = MakeDeadline(wait, storage);
+    pthread_mutex_lock(&sem->lock);
+    int rc = 0;
+    while (sem->count == 0U && rc != ETIMEDOUT && wait != OS_NO_WAIT) {
+        rc = ObjectWait(&sem->cond, &sem->lock, deadline);
+    }
+    OS_Uint status = 1;
+    if (sem->count > 0U) {
+        --sem->count;
+        status = OS_SUCCESS;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return status;
+}
+
+OS_Uint os_semaphore_info_get(OS_Semaphore *s, OS_Ulong *count)
+{
+    if (s == nullptr || *s == nullptr) return 1;
+    if (count != nullptr) {
+        pthread_mutex_lock(&(*s)->lock);
+        *count = (*s)->count;
+        pthread_mutex_unlock(&(*s)->lock);
+    }
+    return OS_SUCCESS;
+}
+
+//==============================================================//
+// QUEUE
+//==============================================================//
+
+OS_Uint os_queue_create(OS_Queue *q, const char * /*name*/, OS_Uint item_words,
+                        void * /*store*/, OS_Ulong length)
+{
+    if (q == nullptr || item_words == 0U || length == 0U) return 1;
+    os_posix_queue_t* queue = static_cast<os_posix_queue_t*>(std::calloc(1, sizeof(os_posix_queue_t)));
+    if (queue == nullptr) return 1;
+    queue->item_size = static_cast<size_t>(item_words) * sizeof(uint32_t);
+    queue->length    = length;
+    queue->buffer    = static_cast<uint8_t*>(std::malloc(queue->item_size * length));
+    if (queue->buffer == nullptr) {
+        std::free(queue);
+        return 1;
+    }
+    pthread_mutex_init(&queue->lock, nullptr);
+    InitCond(&queue->not_empty);
+    InitCond(&queue->not_full);
+    *q = queue;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_queue_create_static(OS_Queue *q, OS_QueueStorage *storage, const char * /*name*/,
+                               OS_Uint item_words, void *store, OS_Ulong length)
+{
+    if (q == nullptr || storage == nullptr || store == nullptr || item_words == 0U || length == 0U) return 1;
+    std::memset(storage, 0, sizeof(*storage));
+    storage->item_size      = static_cast<size_t>(item_words) * sizeof(uint32_t);
+    storage->length         = length;
+    storage->buffer         = static_cast<uint8_t*>(store);
+    storage->static_storage = 1;
+    pthread_mutex_init(&storage->lock, nullptr);
+    InitCond(&storage->not_empty);
+    InitCond(&storage->not_full);
+    *q = storage;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_queue_delete(OS_Queue *q)
+{
+    if (q == nullptr || *q == nullptr) return 1;
+    pthread_cond_destroy(&(*q)->not_full);
+    pthread_cond_destroy(&(*q)->not_empty);
+    pthread_mutex_destroy(&(*q)->lock);
+    if (!(*q)->static_storage) {
+        std::free((*q)->buffer);
+        std::free(*q);
+    }
+    *q = nullptr;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_queue_send(OS_Queue *q, const void *msg, OS_Ulong wait)
+{
+    if (q == nullptr || *q == nullptr || msg == nullptr) return 1;
+    Checkpoint();
+    os_posix_queue_t* queue = *q;
+    timespec storage;
+    const timespec* deadline = MakeDeadline(wait, storage);
+    pthread_mutex_lock(&queue->lock);
+    int rc = 0;
+    while (queue->count == queue->length && rc != ETIMEDOUT && wait != OS_NO_WAIT) {
+        rc = ObjectWait(&queue->not_full, &queue->lock, deadline);
+    }
+    OS_Uint status = 1;
+    if (queue->count < queue->length) {
+        const OS_Ulong tail = (queue->head + queue->count) % queue->length;
+        std::memcpy(queue->buffer + tail * queue->item_size, msg, queue->item_size);
+        ++queue->count;
+        pthread_cond_signal(&queue->not_empty);
+        status = OS_SUCCESS;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return status;
+}
+
+OS_Uint os_queue_receive(OS_Queue *q, void *msg, OS_Ulong wait)
+{
+    if (q == nullptr || *q == nullptr || msg == nullptr) return 1;
+    Checkpoint();
+    os_posix_queue_t* queue = *q;
+    timespec storage;
+    const timespec* deadline = MakeDeadline(wait, storage);
+    pthread_mutex_lock(&queue->lock);
+    int rc = 0;
+    while (queue->count == 0U && rc != ETIMEDOUT && wait != OS_NO_WAIT) {
+        rc = ObjectWait(&queue->not_empty, &queue->lock, deadline);
+    }
+    OS_Uint status = 1;
+    if (queue->count > 0U) {
+        std::memcpy(msg, queue->buffer + queue->head * queue->item_size, queue->item_size);
+        queue->head = (queue->head + 1U) % queue->length;
+        --queue->count;
+        pthread_cond_signal(&queue->not_full);
+        status = OS_SUCCESS;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return status;
+}
+
+OS_Uint os_queue_send_many(OS_Queue *q, const void *msgs, OS_Ulong count,
+                           OS_Ulong *sent, OS_Ulong wait)
+{
+    if (sent != nullptr) *sent = 0;
+    if (q == nullptr || *q == nullptr || (msgs == nullptr && count != 0U)) return 1;
+    Checkpoint();
+    os_posix_queue_t* queue = *q;
+    const uint8_t* in = static_cast<const uint8_t*>(msgs);
+    timespec storage;
+    const timespec* deadline = MakeDeadline(wait, storage);
+    OS_Ulong n = 0;
+    pthread_mutex_lock(&queue->lock);
+    int rc = 0;
+    while (true) {
+        const OS_Ulong batch = std::min(count - n, queue->length - queue->count);
+        for (OS_Ulong i = 0; i < batch; ++i) {
+            const OS_Ulong tail = (queue->head + queue->count) % queue->length;
+            std::memcpy(queue->buffer + tail * queue->item_size, in + (n + i) * queue->item_size, queue->item_size);
+            ++queue->count;
+        }
+        if (batch != 0U) {
+            n += batch;
+            pthread_cond_broadcast(&queue->not_empty);
+        }
+        if (n == count || rc == ETIMEDOUT || wait == OS_NO_WAIT) break;
+        rc = ObjectWait(&queue->not_full, &queue->lock, deadline);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    if (sent != nullptr) *sent = n;
+    return (n == count) ? OS_SUCCESS : (OS_Uint)1;
+}
+
+OS_Uint os_queue_receive_many(OS_Queue *q, void *msgs, OS_Ulong max_count,
+                              OS_Ulong min_count, OS_Ulong *received, OS_Ulong wait)
+{
+    if (received != nullptr) *received = 0;
+    if (q == nullptr || *q == nullptr || (msgs == nullptr && max_count != 0U)) return 1;
+    Checkpoint();
+    os_posix_queue_t* queue = *q;
+    uint8_t* out = static_cast<uint8_t*>(msgs);
+    timespec storage;
+    const timespec* deadline = MakeDeadline(wait, storage);
+    if (min_count > max_count) min_count = max_count;
+    pthread_mutex_lock(&queue->lock);
+    int rc = 0;
+    while (queue->count < min_count && rc != ETIMEDOUT && wait != OS_NO_WAIT) {
+        rc = ObjectWait(&queue->not_empty, &queue->lock, deadline);
+    }
+    const OS_Ulong n = std::min(max_count, queue->count);
+    for (OS_Ulong i = 0; i < n; ++i) {
+        std::memcpy(out + i * queue->item_size, queue->buffer + queue->head * queue->item_size, queue->item_size);
+        queue->head = (queue->head + 1U) % queue->length;
+    }
+    queue->count -= n;
+    if (n != 0U) pthread_cond_broadcast(&queue->not_full);
+    pthread_mutex_unlock(&queue->lock);
+    if (received != nullptr) *received = n;
+    return (n >= min_count) ? OS_SUCCESS : (OS_Uint)1;
+}
+
+//==============================================================//
+// EVENT GROUP
+//==============================================================//
+
+OS_Uint os_event_group_create(OS_EventGroup *g, const char * /*name*/)
+{
+    if (g == nullptr) return 1;
+    os_posix_event_group_t* group = static_cast<os_posix_event_group_t*>(std::calloc(1, sizeof(os_posix_event_group_t)));
+    if (group == nullptr) return 1;
+    EventGroupInit(group, 0);
+    *g = group;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_event_group_delete(OS_EventGroup *g)
+{
+    if (g == nullptr || *g == nullptr) return 1;
+    pthread_cond_destroy(&(*g)->cond);
+    pthread_mutex_destroy(&(*g)->lock);
+    if (!(*g)->static_storage) std::free(*g);
+    *g = nullptr;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_event_group_set(OS_EventGroup *g, OS_Ulong flags)
+{
+    if (g == nullptr || *g == nullptr) return 1;
+    pthread_mutex_lock(&(*g)->lock);
+    (*g)->bits |= flags;
+    pthread_cond_broadcast(&(*g)->cond);
+    pthread_mutex_unlock(&(*g)->lock);
+    return OS_SUCCESS;
+}
+
+OS_Uint os_event_group_clear(OS_EventGroup *g, OS_Ulong flags)
+{
+    if (g == nullptr || *g == nullptr) return 1;
+    pthread_mutex_lock(&(*g)->lock);
+    (*g)->bits &= ~flags;
+    pthread_mutex_unlock(&(*g)->lock);
+    return OS_SUCCESS;
+}
+
+/*
+ * Mirrors the FreeRTOS branch: OS_AND waits for all bits and clears them on
+ * exit, OS_OR waits for any bit; `actual` receives the bits as they were
+ * when the wait ended (satisfied or timed out).
+ */
+OS_Uint os_event_group_get(OS_EventGroup *g, OS_Ulong flags, OS_Uint option,
+                           OS_Ulong *actual, OS_Ulong wait)
+{
+    if (g == nullptr || *g == nullptr) return 1;
+    Checkpoint();
+    os_posix_event_group_t* group = *g;
+    const bool all = (option == OS_AND);
+    timespec storage;
+    const timespec* deadline = MakeDeadline(wait, storage);
+
+    pthread_mutex_lock(&group->lock);
+    auto satisfied = [&]() {
+        return all ? ((group->bits & flags) == flags) : ((group->bits & flags) != 0U);
+    };
+    int rc = 0;
+    while (!satisfied() && rc != ETIMEDOUT && wait != OS_NO_WAIT) {
+        rc = ObjectWait(&group->cond, &group->lock, deadline);
+    }
+    const OS_Ulong bits = group->bits;
+    if (all && satisfied()) {
+        group->bits &= ~flags;
+    }
+    pthread_mutex_unlock(&group->lock);
+    if (actual != nullptr) {
+        *actual = bits;
+    }
+    return OS_SUCCESS;
+}
+
+//==============================================================//
+// TIMER
+//==============================================================//
+
+OS_Uint os_timer_create(OS_Timer *t, const char * /*name*/, void (*cb)(uint32_t),
+                        OS_Ulong id, OS_Ulong initial, OS_Ulong reload,
+                        OS_Uint auto_act)
+{
+    if (t == nullptr || cb == nullptr || initial == 0U) return 1;
+    EnsureGlobals();
+    os_posix_timer_t* timer = static_cast<os_posix_timer_t*>(std::calloc(1, sizeof(os_posix_timer_t)));
+    if (timer == nullptr) return 1;
+    TimerInit(timer, cb, id, initial, reload, 0);
+    *t = timer;
+    if (auto_act) {
+        return os_timer_activate(t);
+    }
+    return OS_SUCCESS;
+}
+
+OS_Uint os_timer_delete(OS_Timer *t)
+{
+    if (t == nullptr || *t == nullptr) return 1;
+    EnsureGlobals();
+    os_posix_timer_t* timer = *t;
+    pthread_mutex_lock(&g_timers.lock);
+    TimerUnlink(timer);
+    // Do not free under a running callback unless we are that callback.
+    while (g_timers.running == timer && !pthread_equal(pthread_self(), g_timers.tid)) {
+        pthread_cond_wait(&g_timers.done, &g_timers.lock);
+    }
+    pthread_mutex_unlock(&g_timers.lock);
+    if (!timer->static_storage) std::free(timer);
+    *t = nullptr;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_timer_create_ctx(OS_Timer *t, os_timer_cb_t *ctx, const char *name,
+                            void (*cb)(uint32_t), OS_Ulong id, OS_Ulong initial,
+                            OS_Ulong reload, OS_Uint auto_act)
+{
+    if (ctx == nullptr) return 1;
+    ctx->cb = cb;
+    ctx->id = id;
+    return os_timer_create(t, name, cb, id, initial, reload, auto_act);
+}
+
+// os_timer_delete already waits out a running callback before returning.
+OS_Uint os_timer_delete_ctx(OS_Timer *t) { return os_timer_delete(t); }
+
+OS_Uint os_timer_activate(OS_Timer *t)
+{
+    if (t == nullptr || *t == nullptr) return 1;
+    EnsureGlobals();
+    os_posix_timer_t* timer = *t;
+    pthread_mutex_lock(&g_timers.lock);
+    if (!EnsureTimerDaemon()) {
+        pthread_mutex_unlock(&g_timers.lock);
+        return 1;
+    }
+    timer->expiry_ns = MonotonicNs() + static_cast<uint64_t>(timer->period) * kNsPerTick;
+    if (!timer->linked) {
+        timer->next    = g_timers.head;
+        g_timers.head  = timer;
+        timer->linked  = 1;
+    }
+    pthread_cond_signal(&g_timers.cond);
+    pthread_mutex_unlock(&g_timers.lock);
+    return OS_SUCCESS;
+}
+
+OS_Uint os_timer_deactivate(OS_Timer *t)
+{
+    if (t == nullptr || *t == nullptr) return 1;
+    EnsureGlobals();
+    pthread_mutex_lock(&g_timers.lock);
+    TimerUnlink(*t);
+    pthread_mutex_unlock(&g_timers.lock);
+    return OS_SUCCESS;
+}
+
+//==============================================================//
+// STATIC ALLOCATION
+//==============================================================//
+
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+
+OS_Uint os_thread_create_static(OS_Thread *t, OS_ThreadStorage * /*storage*/,
+                                const char *name, void (*entry)(OS_Ulong),
+                                OS_Ulong input, uint8_t * /*stack*/, OS_Ulong stack_size,
+                                OS_Uint priority, OS_Uint /*preempt*/, OS_Ulong /*slice*/,
+                                OS_Uint auto_start, int core_id)
+{
+    // The control block is a parking spot for deleted threads, so it cannot
+    // live in storage the caller is free to destroy (see OsAbstraction.h).
+    return ThreadCreate(t, name, entry, input, stack_size, priority, auto_start, core_id);
+}
+
+OS_Uint os_mutex_create_static(OS_Mutex *m, OS_MutexStorage *storage,
+                               const char * /*name*/, OS_Uint /*inherit*/)
+{
+    return MutexInit(m, storage, 0, 1);
+}
+
+OS_Uint os_recursive_mutex_create_static(OS_Mutex *m, OS_MutexStorage *storage,
+                                         const char * /*name*/)
+{
+    return MutexInit(m, storage, 1, 1);
+}
+
+OS_Uint os_semaphore_create_static(OS_Semaphore *s, OS_SemaphoreStorage *storage,
+                                   const char * /*name*/, OS_Uint initial)
+{
+    if (s == nullptr || storage == nullptr) return 1;
+    SemaphoreInit(storage, initial, 1);
+    *s = storage;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_event_group_create_static(OS_EventGroup *g, OS_EventGroupStorage *storage,
+                                     const char * /*name*/)
+{
+    if (g == nullptr || storage == nullptr) return 1;
+    EventGroupInit(storage, 1);
+    *g = storage;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_timer_create_static(OS_Timer *t, OS_TimerStorage *storage, const char * /*name*/,
+                               void (*cb)(uint32_t), OS_Ulong id, OS_Ulong initial,
+                               OS_Ulong reload, OS_Uint auto_act)
+{
+    if (t == nullptr || storage == nullptr || cb == nullptr || initial == 0U) return 1;
+    EnsureGlobals();
+    TimerInit(storage, cb, id, initial, reload, 1);
+    *t = storage;
+    if (auto_act) {
+        return os_timer_activate(t);
+    }
+    return OS_SUCCESS;
+}
+
+OS_Uint os_timer_delete_static(OS_Timer *t) { return os_timer_delete(t); }
+
+#endif  // HF_RTOS_STATIC_ALLOCATION
+
+//==============================================================//
+// STREAM BUFFER
+//==============================================================//
+
+OS_Uint os_stream_buffer_create(OS_StreamBuffer *b, size_t capacity, size_t trigger)
+{
+    if (b == nullptr || capacity == 0U) return 1;
+    os_posix_stream_buffer_t* sb = static_cast<os_posix_stream_buffer_t*>(std::calloc(1, sizeof(os_posix_stream_buffer_t)));
+    if (sb == nullptr) return 1;
+    sb->buffer = static_cast<uint8_t*>(std::malloc(capacity));
+    if (sb->buffer == nullptr) {
+        std::free(sb);
+        return 1;
+    }
+    pthread_mutex_init(&sb->lock, nullptr);
+    InitCond(&sb->cond);
+    sb->capacity = capacity;
+    sb->trigger  = (trigger == 0U) ? 1U : ((trigger > capacity) ? capacity : trigger);
+    *b = sb;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_stream_buffer_delete(OS_StreamBuffer *b)
+{
+    if (b == nullptr || *b == nullptr) return 1;
+    pthread_cond_destroy(&(*b)->cond);
+    pthread_mutex_destroy(&(*b)->lock);
+    std::free((*b)->buffer);
+    std::free(*b);
+    *b = nullptr;
+    return OS_SUCCESS;
+}
+
+OS_Uint os_stream_buffer_send(OS_StreamBuffer *b, const void *data, size_t len, OS_Ulong wait)
+{
+    if (b == nullptr || *b == nullptr || data == nullptr) return 1;
+    os_posix_stream_buffer_t* sb = *b;
+    if (len > sb->capacity) return 1;
+    Checkpoint();
+    timespec storage;
+    const timespec* deadline = MakeDeadline(wait, storage);
+    pthread_mutex_lock(&sb->lock);
+    int rc = 0;
+    while ((sb->capacity - sb->count) < len && rc != ETIMEDOUT && wait != OS_NO_WAIT) {
+        rc = ObjectWait(&sb->cond, &sb->lock, deadline);
+    }
+    OS_Uint status = 1;
+    if ((sb->capacity - sb->count) >= len) {
+        const uint8_t* src = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; ++i) {
+            sb->buffer[(sb->head + sb->count + i) % sb->capacity] = src[i];
+        }
+        sb->count += len;
+        pthread_cond_broadcast(&sb->cond);
+        status = OS_SUCCESS;
+    }
+    pthread_mutex_unlock(&sb->lock);
+    return status;
+}
+
+OS_Uint os_stream_buffer_receive(OS_StreamBuffer *b, void *data, size_t len, OS_Ulong wait)
+{
+    if (b == nullptr || *b == nullptr || data == nullptr || len == 0U) return 1;
+    Checkpoint();
+    os_posix_stream_buffer_t* sb = *b;
+    timespec storage;
+    const timespec* deadline = MakeDeadline(wait, storage);
+    pthread_mutex_lock(&sb->lock);
+    int rc = 0;
+    while (sb->count < sb->trigger && rc != ETIMEDOUT && wait != OS_NO_WAIT) {
+        rc = ObjectWait(&sb->cond, &sb->lock, deadline);
+    }
+    const size_t n = (sb->count < len) ? sb->count : len;
+    uint8_t* dst = static_cast<uint8_t*>(data);
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = sb->buffer[(sb->head + i) % sb->capacity];
+    }
+    sb->head   = (sb->head + n) % sb->capacity;
+    sb->count -= n;
+    if (n > 0U) {
+        pthread_cond_broadcast(&sb->cond);
+    }
+    pthread_mutex_unlock(&sb->lock);
+    return (n > 0U) ? OS_SUCCESS : (OS_Uint)1;
+}
+
+//==============================================================//
+// CRITICAL SECTION
+//==============================================================//
+
+void os_critical_enter(void)
+{
+    EnsureGlobals();
+    pthread_mutex_lock(&os_critical_mux);
+}
+
+void os_critical_exit(void)
+{
+    pthread_mutex_unlock(&os_critical_mux);
+}
+
+#endif /* HF_RTOS_POSIX */
@@ -7,17 +7,33 @@
   *          called with appropriate guards if used within an ISR or shared between tasks.
  * @todo Add @copyright line once project copyright wording is finalised.
   */
-#include <cmath>
 #include "OsAbstraction.h"
 #include "FreeRTOSUtils.h"
 #include "OsUtility.h"
 
+#if defined(HF_RTOS_FREERTOS) && defined(ESP_PLATFORM)
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#endif
+
 //==============================================================//
 // GLOBALS
 //==============================================================//
 
+#if defined(HF_RTOS_FREERTOS)
 // Critical section mutex required by OsAbstraction.h
 OS_Critical os_critical_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+/** Rate of os_get_processor_cycle_count() in counts per microsecond. */
+static inline uint32_t CyclesPerUsec()
+{
+#if defined(HF_RTOS_FREERTOS) && defined(ESP_PLATFORM)
+    return esp_rom_get_cpu_ticks_per_us();
+#else
+    return 1000U;
+#endif
+}
 
 //==============================================================//
 // FUNCTIONS
@@ -61,63 +77,31 @@ void os_delay_time(uint32_t timeBetweenSamples, time_unit_t timeUnit)
 }
 
 uint32_t os_get_elapsed_time_msec() {
-	float elapsedTime = static_cast<float>(os_time_get()) * 1000.0F / osTickRateHz;
-    return static_cast<uint32_t>(std::ceil(elapsedTime));
+    return static_cast<uint32_t>(os_time_get_us() / 1000ULL);
 }
 
 uint32_t os_get_elapsed_processor_cycle_count(uint32_t startCycleCount, time_unit_t unit )
 {
-    static const float time_unit_us_divider = (1000000.0);
-    static const float time_unit_ms_divider = (1000.0);
-	static const float time_unit_s_divider = (1.0);
-	float divider;
+    // Unsigned subtraction is wrap-safe for intervals shorter than one full
+    // counter period: ~17.9 s of CCOUNT at 240 MHz, ~4.29 s of nanoseconds.
+    const uint64_t elapsedUs =
+        static_cast<uint64_t>(os_get_processor_cycle_count() - startCycleCount) / CyclesPerUsec();
 
     switch(unit){
-    	case(TIME_UNIT_US):
-		{
-    		divider = time_unit_us_divider;
-    		break;
-		}
+    	case(TIME_UNIT_US): return static_cast<uint32_t>(elapsedUs);
+    	case(TIME_UNIT_S):  return static_cast<uint32_t>(elapsedUs / 1000000ULL);
     	case(TIME_UNIT_MS):
-		{
-    		divider = time_unit_ms_divider;
-			break;
-		}
-    	case(TIME_UNIT_S):
-		{
-    		divider = time_unit_s_divider;
-			break;
-		}
-    	default:
-		{
-    		divider = time_unit_ms_divider;
-			break;
-		}
+    	default:            return static_cast<uint32_t>(elapsedUs / 1000ULL);
     }
-
-    // ESP32 doesn't have DWT registers, use FreeRTOS tick count instead
-    // Note: This provides lower resolution than ARM DWT but is portable
-    uint32_t current_ticks = xTaskGetTickCount();
-    uint32_t elapsed_ticks;
-    
-    if(startCycleCount > current_ticks)
-    {
-        elapsed_ticks = ~(startCycleCount - current_ticks);
-    }
-    else
-    {
-        elapsed_ticks = current_ticks - startCycleCount;
-    }
-
-    // Convert ticks to the requested time unit
-    // Note: This is an approximation since we're using ticks instead of actual cycles
-    return (uint32_t)(elapsed_ticks * (1000.0 / configTICK_RATE_HZ) / (1000.0 / divider));
 }
 
 uint32_t os_get_processor_cycle_count(){
-    // Return FreeRTOS tick count instead of actual processor cycles
-    // This provides consistent timing across different platforms
-    return xTaskGetTickCount();
+#if defined(HF_RTOS_FREERTOS) && defined(ESP_PLATFORM)
+    return static_cast<uint32_t>(esp_cpu_get_cycle_count());
+#else
+    // No portable cycle counter: count nanoseconds of the monotonic clock.
+    return static_cast<uint32_t>(os_time_get_ns());
+#endif
 }
 
 //constexpr uint32_t os_convert_msec_to_delay_ticks( uint32_t milliseconds )
@@ -391,6 +375,27 @@ bool os_thread_create_ex_pinned(OS_Thread* txThread, const char* name,
     return false;
 }
 
+/**
+ * @brief os_thread_create_ex_pinned with a caller-owned start context.
+ */
+bool os_thread_create_ctx_ex(OS_Thread* txThread, os_thread_start_t& context, const char* name,
+                    void (*entry_function)(OS_Ulong id), OS_Ulong entry_input,
+                    uint8_t* stack, OS_Ulong stackSizeBytes, OS_Uint priority,
+                    OS_Uint preempt_threshold, OS_Ulong timeSliceAllowed,
+                    OS_Uint auto_start, int core_id, bool suppressVerbose ) noexcept
+{
+    OS_Uint err = os_thread_create_ctx(txThread, &context, name, entry_function,
+                                       entry_input, stack, stackSizeBytes, priority,
+                                       preempt_threshold, timeSliceAllowed,
+                                       auto_start, core_id);
+    if (err == OS_SUCCESS)
+    {
+        ++g_ssp_common_thread_count;
+        return true;
+    }
+    return false;
+}
+
 /**
  * @brief Function to Delete TX thread.
  * @param txThread Pointer to the OS thread control block to be deleted.
@@ -446,13 +451,13 @@ bool os_thread_resume_ex( OS_Thread* thread, bool suppressVerbose )
 
 bool os_thread_resume_if_suspended(OS_Thread *thread, bool suppressVerbose) noexcept
 {
-    OS_Uint state = eReady;
+    OS_Uint state = OS_THREAD_READY;
 
     // Get the current state of the thread
     if( OS_SUCCESS == os_thread_info_get(thread, &state) )
     {
 		// Check if the thread is suspended
-                if (state == eSuspended)
+                if (state == OS_THREAD_SUSPENDED)
 		{
 			// If the thread is suspended, attempt to resume it
                         OS_Uint err = os_thread_resume(thread);
@@ -542,6 +547,21 @@ bool os_queue_create_ex(OS_Queue& queue, const char* queueName, OS_Uint messageS
     return false;
 }
 
+/**
+ * @brief Creates a queue in caller-provided storage (no heap allocation).
+ */
+bool os_queue_create_static_ex(OS_Queue& queue, OS_QueueStorage& control, const char* queueName,
+                   OS_Uint messageSizeInWords, void* queueStorage, OS_Ulong queueLength,
+                   bool suppressVerbose) noexcept
+{
+    if (queueName == nullptr)
+    {
+        return false;
+    }
+    return os_queue_create_static(&queue, &control, queueName, messageSizeInWords,
+                                  queueStorage, queueLength) == OS_SUCCESS;
+}
+
 /**
  * @brief Deletes the specified queue and logs any error.
  *
@@ -571,7 +591,7 @@ bool os_queue_delete_ex(OS_Queue& queue, bool suppressVerbose) noexcept
  * @param message - The message to send
  * @param wait_option - The option on how to wait if the queue is full
  */
-bool os_queue_send_ex(OS_Queue& queue, void* message, OS_Ulong wait_option, bool suppressVerbose) noexcept {
+bool os_queue_send_ex(OS_Queue& queue, const void* message, OS_Ulong wait_option, bool suppressVerbose) noexcept {
     OS_Uint status = os_queue_send(&queue, message, wait_option);
     if (status == OS_SUCCESS) {
         return true;
@@ -618,7 +638,8 @@ bool os_timer_create_ex ( OS_Timer& timer, const char* name, void (*callback)(ui
 {
 	if( name != nullptr )
 	{
-		auto status = os_timer_create(&timer, const_cast<char*>(name), callback, callbackExpirationInput, initialTimeoutTicks,
+		auto status = os_timer_create(&timer, const_cast<char*>(name),
+				callback, callbackExpirationInput, initialTimeoutTicks,
 				rescheduleTimeoutTicks, autoActivate);
 		if (status == OS_SUCCESS)
 		{
@@ -667,6 +688,34 @@ bool os_timer_deactivate_and_delete_ex( OS_Timer& timer, bool suppressVerbose) n
 	return status == OS_SUCCESS;
 }
 
+/**
+ * @brief os_timer_create_ex with a caller-owned callback context.
+ */
+bool os_timer_create_ctx_ex( OS_Timer& timer, os_timer_cb_t& context, const char* name,
+                     void (*callback)(uint32_t), uint32_t callbackExpirationInput,
+                     uint32_t initialTimeoutTicks, uint32_t rescheduleTimeoutTicks,
+                     OS_Uint autoActivate, bool suppressVerbose ) noexcept
+{
+    if (name == nullptr)
+    {
+        return false;
+    }
+    return os_timer_create_ctx(&timer, &context, name,
+                               callback, callbackExpirationInput, initialTimeoutTicks,
+                               rescheduleTimeoutTicks, autoActivate) == OS_SUCCESS;
+}
+
+/**
+ * @brief Stops and deletes a timer created by os_timer_create_ctx_ex.
+ */
+bool os_timer_deactivate_and_delete_ctx_ex( OS_Timer& timer, bool suppressVerbose) noexcept
+{
+    // The delete must happen even if the stop fails: the caller is about to
+    // release the context.
+    (void)os_timer_deactivate(&timer);
+    return os_timer_delete_ctx(&timer) == OS_SUCCESS;
+}
+
 bool os_timer_activate_ex( OS_Timer& timer, bool suppressVerbose) noexcept
 {
    auto status = os_timer_activate(&timer);
@@ -927,6 +976,79 @@ bool os_event_flags_get_ex(OS_EventGroup& eventFlags, OS_Ulong flagsToGet, OS_Ui
     }
 }
 
+//============================================================================================//
+// STATIC ALLOCATION
+//============================================================================================//
+
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+
+bool os_mutex_create_static_ex(OS_Mutex& mutex, OS_MutexStorage& storage, const char* mutexName,
+                               OS_Uint inherit, bool suppressVerbose) noexcept
+{
+    if (mutexName == nullptr)
+    {
+        return false;
+    }
+    return os_mutex_create_static(&mutex, &storage, mutexName, inherit) == OS_SUCCESS;
+}
+
+bool os_thread_create_static_ex(OS_Thread* txThread, OS_ThreadStorage& storage, const char* name,
+                    void (*entry_function)(OS_Ulong id), OS_Ulong entry_input,
+                    uint8_t* stack, OS_Ulong stackSizeBytes, OS_Uint priority,
+                    OS_Uint preempt_threshold, OS_Ulong timeSliceAllowed,
+                    OS_Uint auto_start, int core_id, bool suppressVerbose) noexcept
+{
+    OS_Uint err = os_thread_create_static(txThread, &storage, name, entry_function,
+                                          entry_input, stack, stackSizeBytes, priority,
+                                          preempt_threshold, timeSliceAllowed,
+                                          auto_start, core_id);
+    if (err == OS_SUCCESS)
+    {
+        ++g_ssp_common_thread_count;
+        return true;
+    }
+    return false;
+}
+
+bool os_timer_create_static_ex(OS_Timer& timer, OS_TimerStorage& storage, const char* name,
+                     void (*callback)(uint32_t), uint32_t callbackExpirationInput,
+                     uint32_t initialTimeoutTicks, uint32_t rescheduleTimeoutTicks,
+                     OS_Uint autoActivate, bool suppressVerbose) noexcept
+{
+    if (name == nullptr)
+    {
+        return false;
+    }
+    return os_timer_create_static(&timer, &storage, name,
+                                  callback, callbackExpirationInput, initialTimeoutTicks,
+                                  rescheduleTimeoutTicks, autoActivate) == OS_SUCCESS;
+}
+
+bool os_timer_deactivate_and_delete_static_ex(OS_Timer& timer, bool suppressVerbose) noexcept
+{
+    // As for the _ctx variant, delete even if the stop fails.
+    (void)os_timer_deactivate(&timer);
+    return os_timer_delete_static(&timer) == OS_SUCCESS;
+}
+
+bool os_semaphore_create_static_ex(OS_Semaphore* txSemaphore, OS_SemaphoreStorage& storage,
+                       const char* name, OS_Uint initial_count, bool suppressVerbose) noexcept
+{
+    return os_semaphore_create_static(txSemaphore, &storage, name, initial_count) == OS_SUCCESS;
+}
+
+bool os_event_flags_create_static_ex(OS_EventGroup& eventFlags, OS_EventGroupStorage& storage,
+                       const char* name, bool suppressVerbose) noexcept
+{
+    if (name == nullptr)
+    {
+        return false;
+    }
+    return os_event_group_create_static(&eventFlags, &storage, name) == OS_SUCCESS;
+}
+
+#endif // HF_RTOS_STATIC_ALLOCATION
+
 //============================================================================================//
 // STACK FAULT HANDLER
 //============================================================================================//
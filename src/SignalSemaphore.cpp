@@ -35,7 +35,22 @@
  * @param nameExtension Optional name extension for uniqueness.
  */
 SignalSemaphore::SignalSemaphore(const char* baseName, const char* nameExtension) noexcept :
+    SignalSemaphore(baseName, nameExtension, Mode::Semaphore)
+{
+}
+
+/**
+ * @brief Constructor selecting the backing primitive.
+ * @param baseName Base name of the semaphore.
+ * @param nameExtension Optional name extension for uniqueness.
+ * @param signalMode Backing primitive.
+ */
+SignalSemaphore::SignalSemaphore(const char* baseName, const char* nameExtension, Mode signalMode) noexcept :
+    mode(signalMode),
+    waiter{},
+    pendingSignals{0},
     semaphore{},
+    wake{},
     name{},
     initialized(false)
 {
@@ -55,7 +70,7 @@ SignalSemaphore::SignalSemaphore(const char* baseName, const char* nameExtension
  */
 SignalSemaphore::~SignalSemaphore()
 {
-    if (initialized)
+    if (initialized && mode == Mode::Semaphore)
     {
         os_semaphore_delete_ex(&semaphore);
     }
@@ -68,11 +83,24 @@ SignalSemaphore::~SignalSemaphore()
  */
 bool SignalSemaphore::WaitUntilSignalled(uint32_t msecToWait) noexcept
 {
-    if (EnsureInitialized())
+    if (!EnsureInitialized())
+    {
+        return false;
+    }
+    if (mode == Mode::TaskNotify)
     {
-        return (os_semaphore_get_ex(&semaphore, msecToWait));
+        // Only the bound waiter may consume notifications; bind on first use.
+        OS_Thread self = os_thread_self();
+        OS_Thread expected{};
+        if (self == OS_Thread{} ||
+            (!waiter.compare_exchange_strong(expected, self) && expected != self))
+        {
+            return false;
+        }
+        FlushPendingSignals(self);
+        return os_thread_notify_take(msecToWait) == OS_SUCCESS;
     }
-    return false;
+    return (os_semaphore_get_ex(&semaphore, msecToWait));
 }
 
 /**
@@ -81,12 +109,63 @@ bool SignalSemaphore::WaitUntilSignalled(uint32_t msecToWait) noexcept
  */
 bool SignalSemaphore::Signal() noexcept
 {
-    if (EnsureInitialized())
+    if (!EnsureInitialized())
+    {
+        return false;
+    }
+    if (mode == Mode::TaskNotify)
+    {
+        OS_Thread target = waiter.load();
+        if (target == OS_Thread{})
+        {
+            // No waiter yet: count the signal; whoever binds one delivers it.
+            // Re-check after counting in case the waiter bound meanwhile.
+            pendingSignals.fetch_add(1U);
+            target = waiter.load();
+            if (target != OS_Thread{})
+            {
+                FlushPendingSignals(target);
+            }
+        }
+        else if (os_thread_notify_give(&target) != OS_SUCCESS)
+        {
+            return false;
+        }
+    }
+    else
     {
         os_semaphore_put_ex(&semaphore);
-        return true;
     }
-    return false;
+    (void)wake.Signal();
+    return true;
+}
+
+/**
+ * @brief Signals the semaphore from an interrupt handler.
+ * @param yield Collects the task-woken flag for the handler.
+ * @return True if the semaphore was successfully signaled, false otherwise.
+ */
+bool SignalSemaphore::SignalFromIsr(IsrYieldScope& yield) noexcept
+{
+    if (!initialized)
+    {
+        return false;
+    }
+    if (mode == Mode::TaskNotify)
+    {
+        OS_Thread target = waiter.load();
+        if (target == OS_Thread{} ||
+            os_thread_notify_give_from_isr(&target, yield.Flag()) != OS_SUCCESS)
+        {
+            return false;
+        }
+    }
+    else if (os_semaphore_put_from_isr(&semaphore, yield.Flag()) != OS_SUCCESS)
+    {
+        return false;
+    }
+    (void)wake.SignalFromIsr(yield);
+    return true;
 }
 
 /**
@@ -95,12 +174,56 @@ bool SignalSemaphore::Signal() noexcept
  */
 bool SignalSemaphore::IsSignalled() noexcept
 {
-    if (EnsureInitialized())
+    if (!EnsureInitialized())
+    {
+        return false;
+    }
+    if (mode == Mode::TaskNotify)
+    {
+        OS_Thread target = waiter.load();
+        if (target == OS_Thread{})
+        {
+            return pendingSignals.load() > 0U;
+        }
+        return os_thread_notify_peek(&target) > 0;
+    }
+    OS_Ulong currentValue = os_semaphore_get_count_ex(&semaphore);
+    return (currentValue > 0);
+}
+
+/**
+ * @brief Binds the thread that waits on this signal (Mode::TaskNotify only).
+ * @param thread Handle of the waiting thread.
+ * @return False in Mode::Semaphore or if a different waiter is already bound.
+ */
+bool SignalSemaphore::SetWaiter(OS_Thread thread) noexcept
+{
+    if (mode != Mode::TaskNotify || thread == OS_Thread{})
     {
-        OS_Ulong currentValue = os_semaphore_get_count_ex(&semaphore);
-        return (currentValue > 0);
+        return false;
+    }
+    OS_Thread expected{};
+    if (!waiter.compare_exchange_strong(expected, thread) && expected != thread)
+    {
+        return false;
+    }
+    FlushPendingSignals(thread);
+    return true;
+}
+
+/**
+ * @brief Give @p target every signal counted while no waiter was bound.
+ *
+ * Runs after binding and after counting; the exchange hands each counted
+ * signal to exactly one of those callers.
+ * @param target The bound waiter.
+ */
+void SignalSemaphore::FlushPendingSignals(OS_Thread target) noexcept
+{
+    for (uint32_t count = pendingSignals.exchange(0U); count > 0U; --count)
+    {
+        (void)os_thread_notify_give(&target);
     }
-    return false;
 }
 
 /**
@@ -127,9 +250,17 @@ const char* SignalSemaphore::GetName() const noexcept
  */
 bool SignalSemaphore::EnsureInitialized() noexcept
 {
+    if (!initialized && mode == Mode::TaskNotify)
+    {
+        initialized = true;  // Nothing to create: the waiter's notification slot is used.
+    }
     if (!initialized)
     {
+#if defined(HF_RTOS_STATIC_ALLOCATION)
+        initialized = os_semaphore_create_static_ex(&semaphore, semaphoreStorage, name, 0);
+#else
         initialized = os_semaphore_create_ex(&semaphore, name, 0);
+#endif
     }
     return initialized;
 }
@@ -0,0 +1,64 @@
+/**
+ * @file HostTest.h
+ * @brief Check and timing helpers shared by the host tests and benchmarks.
+ *
+ * There is no test framework: each test is a `main()` that counts failed
+ * `HOST_CHECK`s and returns non-zero if there were any, so ctest can run it
+ * directly. Everything here runs on the POSIX backend only.
+ */
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "OsAbstraction.h"
+
+namespace host_test {
+
+inline int& Failures() noexcept
+{
+    static int failures = 0;
+    return failures;
+}
+
+/// Print the verdict for @p name and return the process exit code.
+inline int Finish(const char* name) noexcept
+{
+    if (Failures() != 0) {
+        std::printf("%s: FAILED (%d checks)\n", name, Failures());
+        return 1;
+    }
+    std::printf("%s: OK\n", name);
+    return 0;
+}
+
+/// Stress duration: HF_STRESS_SECONDS from the environment, else @p fallback.
+inline uint32_t StressSeconds(uint32_t fallback) noexcept
+{
+    const char* value = std::getenv("HF_STRESS_SECONDS");
+    if (value == nullptr) return fallback;
+    const long seconds = std::strtol(value, nullptr, 10);
+    return (seconds > 0) ? static_cast<uint32_t>(seconds) : fallback;
+}
+
+/// Monotonic microseconds, as seen by the library itself.
+inline uint64_t NowUs() noexcept { return os_time_get_us(); }
+
+/// Items per second for @p count items in @p elapsedUs.
+inline double PerSecond(uint64_t count, uint64_t elapsedUs) noexcept
+{
+    return (elapsedUs == 0U) ? 0.0 : static_cast<double>(count) * 1e6 / static_cast<double>(elapsedUs);
+}
+
+} // namespace host_test
+
+#define HOST_CHECK(cond)                                                              \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);     \
+            ++host_test::Failures();                                                  \
+        }                                                                             \
+    } while (0)
+
+#endif /* HOST_TEST_H_ */
@@ -0,0 +1,153 @@
+/**
+ * @file bench_queues.cpp
+ * @brief Messages per second through the queue types on the POSIX backend.
+ *
+ * Each row moves `kMessages` 32-bit values from the producer thread(s) to
+ * the consumer thread(s) with blocking calls and reports the rate. It then
+ * reports OsQueue's SendMany / ReceiveMany at several batch sizes, and the
+ * cost of an uncontended send + receive pair on one thread. Host numbers
+ * only rank the implementations; absolute rates on the target differ.
+ *
+ * Usage: bench_queues [messages]
+ */
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "HostTest.h"
+#include "OsMpmcQueue.h"
+#include "OsQueue.h"
+#include "OsSpscQueue.h"
+
+namespace {
+
+constexpr size_t kDepth = 1024U;
+
+/// Move @p total values through @p queue with @p producers / @p consumers
+/// threads; returns messages per second.
+template <typename Queue>
+double Pipe(Queue& queue, unsigned producers, unsigned consumers, uint32_t total)
+{
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint32_t> received{0};
+    std::vector<std::thread> threads;
+
+    const uint64_t start = host_test::NowUs();
+    for (unsigned p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (uint32_t i = p; i < total; i += producers) {
+                (void)queue.Send(i);
+            }
+        });
+    }
+    for (unsigned c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            uint64_t local = 0;
+            while (received.fetch_add(1U, std::memory_order_relaxed) < total) {
+                uint32_t value = 0;
+                (void)queue.Receive(value);
+                local += value;
+            }
+            sum.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const uint64_t elapsedUs = host_test::NowUs() - start;
+
+    HOST_CHECK(sum.load() == static_cast<uint64_t>(total) * (total - 1U) / 2U);
+    return host_test::PerSecond(total, elapsedUs);
+}
+
+/// 1P/1C through @p queue in batches of @p batch items (SendMany /
+/// ReceiveMany); returns messages per second.
+template <typename Queue>
+double BatchPipe(Queue& queue, size_t batch, uint32_t total)
+{
+    static uint32_t sendBuffer[kDepth];
+    static uint32_t receiveBuffer[kDepth];
+    uint64_t sum = 0;
+
+    const uint64_t start = host_test::NowUs();
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < total;) {
+            const size_t count = (total - i < batch) ? total - i : batch;
+            for (size_t k = 0; k < count; ++k) sendBuffer[k] = i + static_cast<uint32_t>(k);
+            i += static_cast<uint32_t>(queue.SendMany(sendBuffer, count));
+        }
+    });
+    for (uint32_t received = 0; received < total;) {
+        const size_t count = queue.ReceiveMany(receiveBuffer, batch);
+        for (size_t k = 0; k < count; ++k) sum += receiveBuffer[k];
+        received += static_cast<uint32_t>(count);
+    }
+    producer.join();
+    const uint64_t elapsedUs = host_test::NowUs() - start;
+
+    HOST_CHECK(sum == static_cast<uint64_t>(total) * (total - 1U) / 2U);
+    return host_test::PerSecond(total, elapsedUs);
+}
+
+/// Nanoseconds per uncontended send + receive on one thread.
+template <typename Queue, typename SendFn, typename ReceiveFn>
+double PairNs(Queue& queue, uint32_t total, SendFn send, ReceiveFn receive)
+{
+    uint32_t value = 0;
+    const uint64_t start = host_test::NowUs();
+    for (uint32_t i = 0; i < total; ++i) {
+        (void)send(queue, i);
+        (void)receive(queue, value);
+    }
+    const uint64_t elapsedUs = host_test::NowUs() - start;
+    return static_cast<double>(elapsedUs) * 1000.0 / static_cast<double>(total);
+}
+
+void Row(const char* name, const char* shape, double rate)
+{
+    std::printf("%-28s %-6s %8.2f M msg/s\n", name, shape, rate / 1e6);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32_t total = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1000000U;
+    std::printf("%u messages, depth %zu, %u hardware threads\n\n", total, kDepth,
+                std::thread::hardware_concurrency());
+
+    static OsQueue<uint32_t, kDepth>     osQueue("bench");
+    static OsSpscQueue<uint32_t, kDepth> spsc("bench");
+    static OsMpmcQueue<uint32_t, kDepth> mpmc("bench");
+
+    Row("OsQueue", "1P/1C", Pipe(osQueue, 1U, 1U, total));
+    Row("OsSpscQueue", "1P/1C", Pipe(spsc, 1U, 1U, total));
+    Row("OsMpmcQueue", "1P/1C", Pipe(mpmc, 1U, 1U, total));
+    Row("OsQueue", "4P/1C", Pipe(osQueue, 4U, 1U, total));
+    Row("OsMpmcQueue", "4P/1C", Pipe(mpmc, 4U, 1U, total));
+    Row("OsQueue", "4P/4C", Pipe(osQueue, 4U, 4U, total));
+    Row("OsMpmcQueue", "4P/4C", Pipe(mpmc, 4U, 4U, total));
+
+    std::printf("\nOsQueue SendMany / ReceiveMany, 1P/1C:\n");
+    for (size_t batch : {1U, 16U, 64U, 256U}) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "batch %zu", batch);
+        Row(name, "1P/1C", BatchPipe(osQueue, batch, total));
+    }
+
+    std::printf("\nuncontended send + receive pair:\n");
+    std::printf("%-28s %8.1f ns\n", "OsQueue",
+                PairNs(osQueue, total,
+                       [](auto& q, uint32_t v) { return q.Send(v, 0U); },
+                       [](auto& q, uint32_t& v) { return q.Receive(v, 0U); }));
+    std::printf("%-28s %8.1f ns\n", "OsSpscQueue",
+                PairNs(spsc, total,
+                       [](auto& q, uint32_t v) { return q.TrySend(v); },
+                       [](auto& q, uint32_t& v) { return q.TryReceive(v); }));
+    std::printf("%-28s %8.1f ns\n", "OsMpmcQueue",
+                PairNs(mpmc, total,
+                       [](auto& q, uint32_t v) { return q.TrySend(v); },
+                       [](auto& q, uint32_t& v) { return q.TryReceive(v); }));
+
+    return (host_test::Failures() != 0) ? 1 : 0;
+}
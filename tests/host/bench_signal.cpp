@@ -0,0 +1,121 @@
+/**
+ * @file bench_signal.cpp
+ * @brief SignalSemaphore Mode::Semaphore vs Mode::TaskNotify on the POSIX
+ *        backend.
+ *
+ * Reports the signal-to-wake latency from a ping-pong between two threads,
+ * each blocked on its own SignalSemaphore, and the cost of an uncontended
+ * Signal + WaitUntilSignalled pair on one thread.
+ *
+ * Usage: bench_signal [round trips]
+ */
+#include <atomic>
+#include <cstdlib>
+#include "HostTest.h"
+#include "SignalSemaphore.h"
+
+namespace {
+
+struct PingPong {
+    SignalSemaphore   ping;
+    SignalSemaphore   pong;
+    uint32_t          rounds;
+    std::atomic<bool> done{false};
+
+    PingPong(SignalSemaphore::Mode mode, uint32_t roundCount) noexcept
+        : ping("Ping", nullptr, mode), pong("Pong", nullptr, mode), rounds(roundCount) {}
+};
+
+void Server(OS_Ulong arg)
+{
+    PingPong& pp = *reinterpret_cast<PingPong*>(arg);
+    for (uint32_t i = 0; i < pp.rounds; ++i) {
+        (void)pp.ping.WaitUntilSignalled(UINT32_MAX);
+        (void)pp.pong.Signal();
+    }
+}
+
+void Client(OS_Ulong arg)
+{
+    PingPong& pp = *reinterpret_cast<PingPong*>(arg);
+    for (uint32_t i = 0; i < pp.rounds; ++i) {
+        (void)pp.ping.Signal();
+        (void)pp.pong.WaitUntilSignalled(UINT32_MAX);
+    }
+    pp.done.store(true);
+}
+
+/// Mean one-way signal-to-wake latency in microseconds.
+double WakeLatencyUs(SignalSemaphore::Mode mode, uint32_t rounds)
+{
+    PingPong pp(mode, rounds);
+    OS_Thread server = nullptr;
+    OS_Thread client = nullptr;
+
+    const uint64_t start = host_test::NowUs();
+    HOST_CHECK(os_thread_create(&server, "Server", Server, reinterpret_cast<OS_Ulong>(&pp), nullptr,
+                                16384U, 1U, 1U, 0U, 1U) == OS_SUCCESS);
+    HOST_CHECK(os_thread_create(&client, "Client", Client, reinterpret_cast<OS_Ulong>(&pp), nullptr,
+                                16384U, 1U, 1U, 0U, 1U) == OS_SUCCESS);
+    while (!pp.done.load()) {
+        (void)os_thread_sleep(1U);
+    }
+    const uint64_t elapsedUs = host_test::NowUs() - start;
+
+    (void)os_thread_delete(&server);
+    (void)os_thread_delete(&client);
+    return static_cast<double>(elapsedUs) / (2.0 * static_cast<double>(rounds));
+}
+
+struct Uncontended {
+    SignalSemaphore::Mode mode;
+    uint32_t              rounds;
+    uint64_t              elapsedUs{0};
+    std::atomic<bool>     done{false};
+};
+
+void UncontendedEntry(OS_Ulong arg)
+{
+    Uncontended& run = *reinterpret_cast<Uncontended*>(arg);
+    SignalSemaphore semaphore("Solo", nullptr, run.mode);
+    (void)semaphore.SetWaiter(os_thread_self());
+    const uint64_t start = host_test::NowUs();
+    for (uint32_t i = 0; i < run.rounds; ++i) {
+        (void)semaphore.Signal();
+        (void)semaphore.WaitUntilSignalled(0U);
+    }
+    run.elapsedUs = host_test::NowUs() - start;
+    run.done.store(true);
+}
+
+/// Nanoseconds per Signal + WaitUntilSignalled on the waiting thread itself.
+double PairNs(SignalSemaphore::Mode mode, uint32_t rounds)
+{
+    Uncontended run{mode, rounds};
+    OS_Thread thread = nullptr;
+    HOST_CHECK(os_thread_create(&thread, "Solo", UncontendedEntry, reinterpret_cast<OS_Ulong>(&run), nullptr,
+                                16384U, 1U, 1U, 0U, 1U) == OS_SUCCESS);
+    while (!run.done.load()) {
+        (void)os_thread_sleep(1U);
+    }
+    (void)os_thread_delete(&thread);
+    return static_cast<double>(run.elapsedUs) * 1000.0 / static_cast<double>(rounds);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32_t rounds = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 200000U;
+    std::printf("%u round trips\n\n", rounds);
+
+    std::printf("%-12s %16s %18s\n", "mode", "wake latency", "uncontended pair");
+    std::printf("%-12s %13.2f us %15.1f ns\n", "Semaphore",
+                WakeLatencyUs(SignalSemaphore::Mode::Semaphore, rounds),
+                PairNs(SignalSemaphore::Mode::Semaphore, rounds * 10U));
+    std::printf("%-12s %13.2f us %15.1f ns\n", "TaskNotify",
+                WakeLatencyUs(SignalSemaphore::Mode::TaskNotify, rounds),
+                PairNs(SignalSemaphore::Mode::TaskNotify, rounds * 10U));
+
+    return (host_test::Failures() != 0) ? 1 : 0;
+}
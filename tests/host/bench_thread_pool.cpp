@@ -0,0 +1,94 @@
+/**
+ * @file bench_thread_pool.cpp
+ * @brief ThreadPool task throughput at 1 / 2 / 4 / 8 workers on the POSIX
+ *        backend.
+ *
+ * Two workloads, each task spinning for about `kWorkIterations` loop
+ * iterations:
+ *  - external: the main thread submits every task (injection queue);
+ *  - fork-join: a binary task tree forked from inside the workers (local
+ *    deques and stealing).
+ * Scaling is bounded by the host's CPU count, printed first.
+ *
+ * Usage: bench_thread_pool [tasks]
+ */
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include "HostTest.h"
+#include "ThreadPool.h"
+
+namespace {
+
+constexpr uint32_t kStackBytes     = 16384U;
+constexpr uint32_t kWorkIterations = 2000U;
+
+void Work() noexcept
+{
+    volatile uint32_t sink = 0;
+    for (uint32_t i = 0; i < kWorkIterations; ++i) {
+        sink = sink + i;
+    }
+}
+
+template <typename Pool>
+void ForkTree(Pool& pool, std::atomic<uint32_t>& done, int depth) noexcept
+{
+    Work();
+    done.fetch_add(1U, std::memory_order_relaxed);
+    if (depth == 0) return;
+    PoolHandle left = pool.Submit([&pool, &done, depth]() { ForkTree(pool, done, depth - 1); }, UINT32_MAX);
+    ForkTree(pool, done, depth - 1);
+    (void)pool.Wait(left);
+}
+
+template <size_t Workers>
+void Run(uint32_t tasks)
+{
+    using Pool = ThreadPool<Workers, 256>;
+    static uint8_t stacks[Workers * kStackBytes];
+    static Pool pool("bench", stacks, kStackBytes, 5U);
+    HOST_CHECK(pool.Start());
+
+    std::atomic<uint32_t> done{0};
+    uint64_t start = host_test::NowUs();
+    for (uint32_t i = 0; i < tasks; ++i) {
+        HOST_CHECK(pool.Submit([&done]() { Work(); done.fetch_add(1U, std::memory_order_relaxed); },
+                               UINT32_MAX).IsValid());
+    }
+    while (done.load() < tasks) {
+        (void)os_thread_sleep(0U);
+    }
+    const double external = host_test::PerSecond(tasks, host_test::NowUs() - start);
+
+    /// A tree of depth d has 2^(d+1) - 1 tasks; pick the largest within @p tasks.
+    int depth = 0;
+    while ((2U << (depth + 1)) - 1U <= tasks) ++depth;
+    const uint32_t treeTasks = (2U << depth) - 1U;
+    done.store(0U);
+    start = host_test::NowUs();
+    PoolHandle root = pool.Submit([&done, depth]() { ForkTree(pool, done, depth); }, UINT32_MAX);
+    HOST_CHECK(root.Wait());
+    const double forkJoin = host_test::PerSecond(treeTasks, host_test::NowUs() - start);
+    HOST_CHECK(done.load() == treeTasks);
+
+    HOST_CHECK(pool.Stop());
+    std::printf("%7zu %16.0f %16.0f\n", Workers, external, forkJoin);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32_t tasks = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100000U;
+    std::printf("%u tasks of %u iterations, %u hardware threads\n\n", tasks, kWorkIterations,
+                std::thread::hardware_concurrency());
+    std::printf("%7s %16s %16s\n", "workers", "external task/s", "fork-join task/s");
+
+    Run<1>(tasks);
+    Run<2>(tasks);
+    Run<4>(tasks);
+    Run<8>(tasks);
+
+    return (host_test::Failures() != 0) ? 1 : 0;
+}
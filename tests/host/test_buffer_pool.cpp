@@ -0,0 +1,138 @@
+/**
+ * @file test_buffer_pool.cpp
+ * @brief BufferPool acquire / release accounting, blocking acquire, handle
+ *        hand-off through a BufferQueue, and a contended acquire / release
+ *        stress that checks no block is ever lost or handed out twice.
+ */
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "HostTest.h"
+#include "BufferPool.h"
+#include "OsUtility.h"
+
+namespace {
+
+void TestAccounting()
+{
+    BufferPool<32, 3> pool("pool");
+    HOST_CHECK(pool.IsValid());
+
+    auto a = pool.TryAcquire();
+    auto b = pool.TryAcquire();
+    auto c = pool.TryAcquire();
+    HOST_CHECK(a && b && c);
+    HOST_CHECK(!pool.TryAcquire());
+    HOST_CHECK(pool.GetStats().inUse == 3U && pool.GetStats().exhausted == 1U);
+
+    b.Reset();
+    auto d = pool.TryAcquire();
+    HOST_CHECK(d && d.Data() != a.Data() && d.Data() != c.Data());
+
+    const BufferRef ref = a.Detach();
+    HOST_CHECK(!a && pool.GetStats().inUse == 3U);
+    auto adopted = pool.Adopt(ref);
+    HOST_CHECK(adopted && pool.GetStats().inUse == 3U);
+}
+
+void TestBlockingAcquire()
+{
+    BufferPool<32, 1> pool("pool");
+    auto held = pool.TryAcquire();
+    HOST_CHECK(held);
+
+    const uint64_t start = host_test::NowUs();
+    HOST_CHECK(!pool.Acquire(20U));
+    HOST_CHECK(host_test::NowUs() - start >= 19000U);
+
+    std::thread releaser([&]() { os_delay_msec(30U); held.Reset(); });
+    auto taken = pool.Acquire(1000U);
+    HOST_CHECK(taken);
+    releaser.join();
+}
+
+void TestQueueHandOff()
+{
+    using Pool = BufferPool<64, 4>;
+    static Pool pool("pool");
+    static BufferQueue<Pool, 4> queue("queue", pool);
+
+    std::thread consumer([&]() {
+        for (int i = 0; i < 100; ++i) {
+            Pool::Handle in;
+            if (queue.Receive(in, 1000U)) {
+                HOST_CHECK(in.Length() == 1U && in.Data()[0] == static_cast<uint8_t>(i));
+            }
+        }
+    });
+    for (int i = 0; i < 100; ++i) {
+        Pool::Handle out = pool.Acquire(1000U);
+        HOST_CHECK(out);
+        out.Data()[0] = static_cast<uint8_t>(i);
+        out.SetLength(1U);
+        HOST_CHECK(queue.Send(out, 1000U));
+    }
+    consumer.join();
+    HOST_CHECK(pool.GetStats().inUse == 0U);
+}
+
+/// Many threads racing TryAcquire / Reset on a tiny pool. Each block's first
+/// byte is a claim flag, so a block handed to two owners at once is caught;
+/// afterwards every block must still be acquirable.
+void StressNoLostBlocks(uint32_t seconds)
+{
+    constexpr size_t kBlocks = 3U;
+    static BufferPool<8, kBlocks> pool("pool");
+    std::atomic<bool> stop{false};
+    std::atomic<bool> doubleOwner{false};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto block = pool.TryAcquire();
+                if (!block) continue;
+                std::atomic_ref<uint8_t> flag(block.Data()[0]);
+                if (flag.exchange(1U) != 0U) doubleOwner.store(true);
+                flag.store(0U);
+                block.Reset();
+            }
+        });
+    }
+    /// One blocking acquirer keeps the semaphore path in the mix.
+    threads.emplace_back([&]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto block = pool.Acquire(5U);
+        }
+    });
+
+    const uint64_t endUs = host_test::NowUs() + static_cast<uint64_t>(seconds) * 1000000ULL;
+    while (host_test::NowUs() < endUs) {
+        os_delay_msec(100U);
+    }
+    stop.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    HOST_CHECK(!doubleOwner.load());
+    HOST_CHECK(pool.GetStats().inUse == 0U);
+    BufferPool<8, kBlocks>::Handle all[kBlocks];
+    size_t acquired = 0;
+    for (auto& handle : all) {
+        handle = pool.TryAcquire();
+        if (handle) ++acquired;
+    }
+    HOST_CHECK(acquired == kBlocks);
+}
+
+} // namespace
+
+int main()
+{
+    TestAccounting();
+    TestBlockingAcquire();
+    TestQueueHandOff();
+    StressNoLostBlocks(host_test::StressSeconds(3U));
+    return host_test::Finish("test_buffer_pool");
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test_co_executor.cpp
+ * @brief CoExecutor round-robin order, queue wake-ups, and destroying an
+ *        executor whose thread is still running tasks.
+ */
+#include <atomic>
+#include <memory>
+#include "HostTest.h"
+#include "CoExecutor.h"
+#include "OsQueue.h"
+#include "OsUtility.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+namespace {
+
+constexpr uint32_t kStackBytes = 16384U;
+std::atomic<int> g_order{0};
+std::atomic<int> g_sum{0};
+
+CoTask Yielder(CoExecutorBase& exec, int id)
+{
+    for (int i = 0; i < 3; ++i) {
+        g_order.store(g_order.load() * 10 + id);
+        co_await exec.Yield();
+    }
+}
+
+CoTask Spinner(CoExecutorBase& exec)
+{
+    while (true) {
+        co_await exec.Yield();
+    }
+}
+
+CoTask Consumer(CoExecutorBase& exec, OsQueue<int, 8>& queue)
+{
+    int value;
+    while (co_await exec.Receive(queue, value, 300U)) {
+        g_sum.fetch_add(value);
+    }
+}
+
+void TestRoundRobinAndReceive()
+{
+    static uint8_t stack[kStackBytes];
+    static CoExecutor<8, 256> exec("co", stack, sizeof(stack), 5U);
+    static OsQueue<int, 8> queue("coq");
+    queue.SetWakeTarget(exec.GetWakeTarget());
+
+    HOST_CHECK(exec.Spawn(Consumer(exec, queue)));
+    HOST_CHECK(exec.EnsureInitialized() && exec.StartThreadAndWaitToVerify());
+    for (int i = 1; i <= 100; ++i) {
+        (void)queue.Send(i);
+    }
+    HOST_CHECK(exec.Spawn(Yielder(exec, 1)) && exec.Spawn(Yielder(exec, 2)));
+    os_delay_msec(500U);
+    HOST_CHECK(g_sum.load() == 5050);
+    HOST_CHECK(g_order.load() == 121212);
+    HOST_CHECK(exec.LiveTasks() == 0U);
+    HOST_CHECK(exec.StopThreadAndWaitToVerify(1000U));
+}
+
+/// Destroying a started executor must stop its thread before the task
+/// frames and the BaseThread part go away.
+void TestDestroyWhileRunning()
+{
+    static uint8_t stack[kStackBytes];
+    for (int round = 0; round < 20; ++round) {
+        auto exec = std::make_unique<CoExecutor<4, 256>>("co", stack, sizeof(stack), 5U);
+        HOST_CHECK(exec->Spawn(Spinner(*exec)) && exec->Spawn(Spinner(*exec)));
+        HOST_CHECK(exec->EnsureInitialized() && exec->StartThreadAndWaitToVerify());
+        os_delay_msec(2U);
+        exec.reset();
+    }
+}
+
+} // namespace
+
+int main()
+{
+    TestRoundRobinAndReceive();
+    TestDestroyWhileRunning();
+    return host_test::Finish("test_co_executor");
+}
+
+#else
+
+int main()
+{
+    std::printf("test_co_executor: skipped, no C++20 coroutines\n");
+    return 0;
+}
+
+#endif
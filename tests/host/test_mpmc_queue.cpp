@@ -0,0 +1,145 @@
+/**
+ * @file test_mpmc_queue.cpp
+ * @brief OsMpmcQueue boundaries, waiter wake-ups, and a many-producer /
+ *        many-consumer stress that checks every message arrives exactly
+ *        once and in per-producer order.
+ */
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "HostTest.h"
+#include "OsMpmcQueue.h"
+#include "OsUtility.h"
+
+namespace {
+
+void TestBoundaries()
+{
+    OsMpmcQueue<uint32_t, 4> queue("mpmc");
+    HOST_CHECK(queue.IsValid());
+
+    uint32_t value = 0;
+    HOST_CHECK(!queue.TryReceive(value));
+    for (uint32_t i = 0; i < 4U; ++i) {
+        HOST_CHECK(queue.TrySend(i));
+    }
+    HOST_CHECK(!queue.TrySend(99U));
+    HOST_CHECK(queue.Size() == 4U);
+
+    const uint64_t start = host_test::NowUs();
+    HOST_CHECK(!queue.Send(99U, 20U));
+    HOST_CHECK(host_test::NowUs() - start >= 19000U);
+
+    for (uint32_t i = 0; i < 4U; ++i) {
+        HOST_CHECK(queue.TryReceive(value) && value == i);
+    }
+    HOST_CHECK(!queue.Receive(value, 0U));
+}
+
+void TestWaitersReleased()
+{
+    OsMpmcQueue<uint32_t, 4> queue("mpmc");
+    std::atomic<int> received{0};
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 3; ++i) {
+        consumers.emplace_back([&]() {
+            uint32_t value;
+            if (queue.Receive(value, 2000U)) received.fetch_add(1);
+        });
+    }
+    os_delay_msec(30);
+    for (uint32_t i = 0; i < 3U; ++i) {
+        (void)queue.Send(i, 0U);
+    }
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+    HOST_CHECK(received.load() == 3);
+}
+
+void StressExactlyOnce(uint32_t seconds)
+{
+    constexpr unsigned kProducers = 4U;
+    constexpr unsigned kConsumers = 4U;
+    static OsMpmcQueue<uint32_t, 8> queue("mpmc");
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> sentSum{0};
+    std::atomic<uint64_t> receivedSum{0};
+    std::atomic<uint32_t> sentCount{0};
+    std::atomic<uint32_t> receivedCount{0};
+    std::atomic<bool> inOrder{true};
+    std::vector<std::thread> threads;
+
+    /// Value = producer in the top byte, that producer's sequence below.
+    for (unsigned p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&, p]() {
+            uint32_t sequence = 0;
+            uint64_t sum = 0;
+            while (!stop.load(std::memory_order_relaxed) && sequence < 0xFFFFFFU) {
+                const uint32_t value = (p << 24) | sequence;
+                const bool ok = ((sequence & 1U) != 0U) ? queue.TrySend(value) : queue.Send(value, 10U);
+                if (ok) {
+                    sum += value;
+                    ++sequence;
+                }
+            }
+            sentSum.fetch_add(sum);
+            sentCount.fetch_add(sequence);
+        });
+    }
+
+    std::atomic<unsigned> producersDone{0};
+    for (unsigned c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&]() {
+            int64_t last[kProducers];
+            for (int64_t& entry : last) entry = -1;
+            uint64_t sum = 0;
+            uint32_t count = 0;
+            while (true) {
+                uint32_t value;
+                if (queue.Receive(value, 10U)) {
+                    const uint32_t producer = value >> 24;
+                    const int64_t sequence = value & 0xFFFFFFU;
+                    if (producer >= kProducers || sequence <= last[producer]) inOrder.store(false);
+                    else last[producer] = sequence;
+                    sum += value;
+                    ++count;
+                } else if (producersDone.load() == kProducers) {
+                    break;
+                }
+            }
+            receivedSum.fetch_add(sum);
+            receivedCount.fetch_add(count);
+        });
+    }
+
+    const uint64_t endUs = host_test::NowUs() + static_cast<uint64_t>(seconds) * 1000000ULL;
+    while (host_test::NowUs() < endUs) {
+        os_delay_msec(100U);
+    }
+    stop.store(true);
+    for (unsigned p = 0; p < kProducers; ++p) {
+        threads[p].join();
+    }
+    producersDone.store(kProducers);
+    for (unsigned c = 0; c < kConsumers; ++c) {
+        threads[kProducers + c].join();
+    }
+
+    HOST_CHECK(inOrder.load());
+    HOST_CHECK(receivedCount.load() == sentCount.load());
+    HOST_CHECK(receivedSum.load() == sentSum.load());
+    HOST_CHECK(sentCount.load() > 0U);
+    HOST_CHECK(queue.Size() == 0U);
+}
+
+} // namespace
+
+int main()
+{
+    TestBoundaries();
+    TestWaitersReleased();
+    StressExactlyOnce(host_test::StressSeconds(2U));
+    return host_test::Finish("test_mpmc_queue");
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test_posix_threads.cpp
+ * @brief POSIX backend thread control: creation pinned beyond the online
+ *        CPUs, deleting threads blocked on an object (then destroying the
+ *        object), and the bounded wait when deleting a busy thread.
+ */
+#include <atomic>
+#include "HostTest.h"
+#include "OsUtility.h"
+
+namespace {
+
+constexpr OS_Ulong kStackBytes = 16384U;
+
+std::atomic<int> g_ran{0};
+
+void CountEntry(OS_Ulong) { g_ran.fetch_add(1); }
+
+void TestPinnedBeyondOnlineCores()
+{
+    OS_Thread thread = nullptr;
+    HOST_CHECK(os_thread_create_pinned(&thread, "Pinned", CountEntry, 0U, nullptr, kStackBytes, 1U, 1U, 0U,
+                                       OS_AUTO_START, os_get_core_count()) == OS_SUCCESS);
+    for (int i = 0; i < 100 && g_ran.load() == 0; ++i) {
+        os_delay_msec(10U);
+    }
+    HOST_CHECK(g_ran.load() == 1);
+    HOST_CHECK(os_thread_delete(&thread) == OS_SUCCESS);
+}
+
+void WaitEntry(OS_Ulong arg)
+{
+    OS_Semaphore* semaphore = reinterpret_cast<OS_Semaphore*>(arg);
+    for (;;) {
+        (void)os_semaphore_get(semaphore, 1U);
+    }
+}
+
+/// Deleting a thread that keeps entering and leaving an object wait, then
+/// destroying the object straight away, must not touch freed memory (run it
+/// under ASan).
+void TestDeleteWhileWaiting()
+{
+    for (int round = 0; round < 50; ++round) {
+        OS_Semaphore semaphore = nullptr;
+        OS_Thread thread = nullptr;
+        HOST_CHECK(os_semaphore_create(&semaphore, "Sem", 0U) == OS_SUCCESS);
+        HOST_CHECK(os_thread_create(&thread, "Waiter", WaitEntry, reinterpret_cast<OS_Ulong>(&semaphore),
+                                    nullptr, kStackBytes, 1U, 1U, 0U, OS_AUTO_START) == OS_SUCCESS);
+        os_delay_msec(static_cast<uint16_t>(round % 3));
+        HOST_CHECK(os_thread_delete(&thread) == OS_SUCCESS);
+        HOST_CHECK(os_semaphore_delete(&semaphore) == OS_SUCCESS);
+    }
+}
+
+std::atomic<bool> g_release{false};
+std::atomic<int>  g_afterPark{0};
+
+void BusyEntry(OS_Ulong)
+{
+    while (!g_release.load()) {
+    }
+    os_delay_msec(1U);
+    g_afterPark.fetch_add(1);
+}
+
+/// A thread spinning outside os_* calls cannot park; delete gives up after
+/// HF_RTOS_POSIX_DELETE_WAIT_MS and the thread parks at its next call.
+void TestDeleteBusyThreadIsBounded()
+{
+    OS_Thread thread = nullptr;
+    HOST_CHECK(os_thread_create(&thread, "Busy", BusyEntry, 0U, nullptr, kStackBytes, 1U, 1U, 0U,
+                                OS_AUTO_START) == OS_SUCCESS);
+    os_delay_msec(10U);
+
+    const uint64_t start = host_test::NowUs();
+    HOST_CHECK(os_thread_delete(&thread) == 1U);
+    const uint64_t elapsedMs = (host_test::NowUs() - start) / 1000U;
+    HOST_CHECK(elapsedMs >= HF_RTOS_POSIX_DELETE_WAIT_MS - 1U);
+    HOST_CHECK(elapsedMs < HF_RTOS_POSIX_DELETE_WAIT_MS + 1000U);
+
+    g_release.store(true);
+    os_delay_msec(100U);
+    HOST_CHECK(g_afterPark.load() == 0);
+}
+
+} // namespace
+
+int main()
+{
+    TestPinnedBeyondOnlineCores();
+    TestDeleteWhileWaiting();
+    TestDeleteBusyThreadIsBounded();
+    return host_test::Finish("test_posix_threads");
+}
@@ -0,0 +1,150 @@
+/**
+ * @file test_queue_batch.cpp
+ * @brief OsQueue SendMany / ReceiveMany / DrainInto: partial batches,
+ *        minimum counts with timeouts, padded element types, and a
+ *        producer / consumer stress mixing batch and single-item calls.
+ */
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "HostTest.h"
+#include "OsQueue.h"
+#include "OsUtility.h"
+
+namespace {
+
+struct Odd {
+    uint8_t bytes[3];
+};
+
+void TestPartialBatches()
+{
+    OsQueue<uint32_t, 8> queue("batch");
+    uint32_t in[12];
+    uint32_t out[12] = {};
+    for (uint32_t i = 0; i < 12U; ++i) in[i] = i;
+
+    HOST_CHECK(queue.SendMany(in, 12U, 0U) == 8U);
+    HOST_CHECK(queue.DrainInto(out, 3U) == 3U && out[2] == 2U);
+    HOST_CHECK(queue.DrainInto(out, 12U) == 5U && out[4] == 7U);
+    HOST_CHECK(queue.DrainInto(out, 12U) == 0U);
+
+    uint64_t start = host_test::NowUs();
+    HOST_CHECK(queue.ReceiveMany(out, 12U, 1U, 20U) == 0U);
+    HOST_CHECK(host_test::NowUs() - start >= 19000U);
+
+    /// Fewer than minCount by the deadline: return what arrived.
+    (void)queue.SendMany(in, 2U, 0U);
+    start = host_test::NowUs();
+    HOST_CHECK(queue.ReceiveMany(out, 12U, 4U, 20U) == 2U);
+    HOST_CHECK(host_test::NowUs() - start >= 19000U);
+
+#if defined(__cpp_lib_span)
+    std::vector<uint32_t> items{1U, 2U, 3U};
+    HOST_CHECK(queue.SendMany(std::span<const uint32_t>(items)) == 3U);
+    HOST_CHECK(queue.DrainInto(std::span<uint32_t>(out)) == 3U && out[2] == 3U);
+#endif
+}
+
+void TestBlockingBatches()
+{
+    OsQueue<uint32_t, 8> queue("batch");
+    uint32_t in[12];
+    uint32_t out[12] = {};
+    for (uint32_t i = 0; i < 12U; ++i) in[i] = i;
+
+    std::thread trickle([&]() {
+        for (uint32_t i = 0; i < 5U; ++i) {
+            os_delay_msec(5U);
+            (void)queue.Send(100U + i, 0U);
+        }
+    });
+    HOST_CHECK(queue.ReceiveMany(out, 12U, 5U, 1000U) == 5U && out[4] == 104U);
+    trickle.join();
+
+    std::thread drain([&]() {
+        os_delay_msec(20U);
+        uint32_t sink[8];
+        (void)queue.ReceiveMany(sink, 8U, 8U, 1000U);
+    });
+    HOST_CHECK(queue.SendMany(in, 12U, 1000U) == 12U);
+    drain.join();
+    HOST_CHECK(queue.DrainInto(out, 12U) == 4U && out[0] == 8U);
+}
+
+void TestPaddedType()
+{
+    static OsQueue<Odd, 200> queue("odd");
+    static Odd in[300];
+    static Odd out[300];
+    for (int i = 0; i < 300; ++i) {
+        in[i] = Odd{{static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8), 7U}};
+    }
+
+    HOST_CHECK(queue.SendMany(in, 300U, 0U) == 200U);
+    HOST_CHECK(queue.ReceiveMany(out, 300U, 150U, 0U) == 200U);
+    bool intact = true;
+    for (int i = 0; i < 200; ++i) {
+        intact = intact && out[i].bytes[0] == static_cast<uint8_t>(i) && out[i].bytes[2] == 7U;
+    }
+    HOST_CHECK(intact);
+}
+
+void StressMixed(uint32_t seconds)
+{
+    static OsQueue<uint32_t, 64> queue("batch");
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> sent{0};
+
+    std::thread producer([&]() {
+        uint32_t next = 0;
+        uint32_t batch[37];
+        while (!stop.load(std::memory_order_relaxed)) {
+            if ((next & 3U) == 0U) {
+                if (queue.Send(next, 10U)) ++next;
+                continue;
+            }
+            const size_t count = 1U + (next % 37U);
+            for (size_t i = 0; i < count; ++i) batch[i] = next + static_cast<uint32_t>(i);
+            next += static_cast<uint32_t>(queue.SendMany(batch, count, 10U));
+        }
+        sent.store(next, std::memory_order_release);
+    });
+
+    uint32_t expected = 0;
+    bool inOrder = true;
+    uint32_t out[50];
+    const uint64_t endUs = host_test::NowUs() + static_cast<uint64_t>(seconds) * 1000000ULL;
+    while (host_test::NowUs() < endUs) {
+        const size_t count = ((expected & 1U) != 0U) ? queue.ReceiveMany(out, 50U, 1U + (expected % 7U), 10U)
+                                                     : queue.DrainInto(out, 50U);
+        for (size_t i = 0; i < count; ++i) {
+            inOrder = inOrder && (out[i] == expected);
+            ++expected;
+        }
+    }
+    stop.store(true, std::memory_order_relaxed);
+    producer.join();
+
+    size_t count;
+    while ((count = queue.DrainInto(out, 50U)) != 0U) {
+        for (size_t i = 0; i < count; ++i) {
+            inOrder = inOrder && (out[i] == expected);
+            ++expected;
+        }
+    }
+    HOST_CHECK(inOrder);
+    HOST_CHECK(expected == sent.load(std::memory_order_acquire));
+    HOST_CHECK(expected > 0U);
+}
+
+} // namespace
+
+int main()
+{
+    TestPartialBatches();
+    TestBlockingBatches();
+    TestPaddedType();
+    StressMixed(host_test::StressSeconds(2U));
+    return host_test::Finish("test_queue_batch");
+}
@@ -0,0 +1,102 @@
+/**
+ * @file test_spsc_queue.cpp
+ * @brief OsSpscQueue boundaries, blocking fallback, and a one-producer /
+ *        one-consumer ordering stress through a ring small enough that both
+ *        sides keep hitting full and empty.
+ */
+#include <atomic>
+#include <thread>
+#include "HostTest.h"
+#include "OsSpscQueue.h"
+#include "OsUtility.h"
+
+namespace {
+
+void TestBoundaries()
+{
+    OsSpscQueue<uint32_t, 4> queue("spsc");
+    HOST_CHECK(queue.IsValid());
+
+    uint32_t value = 0;
+    HOST_CHECK(!queue.TryReceive(value));
+    for (uint32_t i = 0; i < 4U; ++i) {
+        HOST_CHECK(queue.TrySend(i));
+    }
+    HOST_CHECK(!queue.TrySend(99U));
+    HOST_CHECK(queue.Size() == 4U);
+
+    const uint64_t start = host_test::NowUs();
+    HOST_CHECK(!queue.Send(99U, 20U));
+    HOST_CHECK(host_test::NowUs() - start >= 19000U);
+
+    for (uint32_t i = 0; i < 4U; ++i) {
+        HOST_CHECK(queue.TryReceive(value) && value == i);
+    }
+    HOST_CHECK(!queue.Receive(value, 0U));
+}
+
+void TestBlockingHandOff()
+{
+    OsSpscQueue<uint32_t, 4> queue("spsc");
+    uint32_t value = 0;
+
+    std::thread producer([&]() { os_delay_msec(30); (void)queue.TrySend(77U); });
+    HOST_CHECK(queue.Receive(value, 1000U) && value == 77U);
+    producer.join();
+
+    for (uint32_t i = 0; i < 4U; ++i) {
+        (void)queue.TrySend(i);
+    }
+    std::thread consumer([&]() { os_delay_msec(30); uint32_t item; (void)queue.TryReceive(item); });
+    HOST_CHECK(queue.Send(5U, 1000U));
+    consumer.join();
+}
+
+void StressOrdering(uint32_t seconds)
+{
+    static OsSpscQueue<uint32_t, 8> queue("spsc");
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> sent{0};
+
+    std::thread producer([&]() {
+        uint32_t next = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            /// Mix the lock-free and blocking paths.
+            const bool ok = ((next & 1U) != 0U) ? queue.TrySend(next) : queue.Send(next, 10U);
+            if (ok) ++next;
+        }
+        sent.store(next, std::memory_order_release);
+    });
+
+    uint32_t expected = 0;
+    bool inOrder = true;
+    const uint64_t endUs = host_test::NowUs() + static_cast<uint64_t>(seconds) * 1000000ULL;
+    while (host_test::NowUs() < endUs) {
+        uint32_t value;
+        if (queue.Receive(value, 10U)) {
+            inOrder = inOrder && (value == expected);
+            ++expected;
+        }
+    }
+    stop.store(true, std::memory_order_relaxed);
+    producer.join();
+
+    uint32_t value;
+    while (queue.TryReceive(value)) {
+        inOrder = inOrder && (value == expected);
+        ++expected;
+    }
+    HOST_CHECK(inOrder);
+    HOST_CHECK(expected == sent.load(std::memory_order_acquire));
+    HOST_CHECK(expected > 0U);
+}
+
+} // namespace
+
+int main()
+{
+    TestBoundaries();
+    TestBlockingHandOff();
+    StressOrdering(host_test::StressSeconds(2U));
+    return host_test::Finish("test_spsc_queue");
+}
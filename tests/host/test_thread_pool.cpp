@@ -0,0 +1,155 @@
+/**
+ * @file test_thread_pool.cpp
+ * @brief ThreadPool submit / wait, slot exhaustion, fork-join from workers,
+ *        restart, and a WorkStealingDeque owner-vs-thieves stress that checks
+ *        every pushed item is taken exactly once.
+ */
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "HostTest.h"
+#include "ThreadPool.h"
+
+namespace {
+
+constexpr uint32_t kStackBytes = 16384U;
+uint8_t g_stacks[4 * kStackBytes];
+ThreadPool<4, 64> g_pool("pool", g_stacks, kStackBytes, 5U);
+std::atomic<int> g_leaves{0};
+
+void Fork(int depth)
+{
+    if (depth == 0) {
+        g_leaves.fetch_add(1);
+        return;
+    }
+    PoolHandle child = g_pool.Submit([depth]() { Fork(depth - 1); }, 1000U);
+    Fork(depth - 1);
+    HOST_CHECK(child.IsValid());
+    (void)g_pool.Wait(child);
+}
+
+void TestSubmitAndWait()
+{
+    std::atomic<int> sum{0};
+    PoolHandle handles[64];
+    for (int i = 1; i <= 64; ++i) {
+        handles[i - 1] = g_pool.Submit([i, &sum]() { sum.fetch_add(i); }, 1000U);
+        HOST_CHECK(handles[i - 1].IsValid());
+    }
+    for (PoolHandle& handle : handles) {
+        HOST_CHECK(handle.Wait(2000U));
+    }
+    HOST_CHECK(sum.load() == 64 * 65 / 2);
+}
+
+void TestSlotExhaustion()
+{
+    std::atomic<bool> gate{false};
+    PoolHandle blockers[64];
+    for (PoolHandle& handle : blockers) {
+        handle = g_pool.Submit([&gate]() { while (!gate.load()) (void)os_thread_sleep(1U); });
+    }
+    HOST_CHECK(!g_pool.Submit([]() {}).IsValid());
+    gate.store(true);
+    for (PoolHandle& handle : blockers) {
+        HOST_CHECK(handle.Wait(2000U));
+    }
+
+    PoolHandle slow = g_pool.Submit([]() { (void)os_thread_sleep(200U); });
+    HOST_CHECK(!slow.Wait(20U));
+    HOST_CHECK(slow.Wait(1000U));
+}
+
+void TestForkJoinAndRestart()
+{
+    PoolHandle root = g_pool.Submit([]() { Fork(6); }, 1000U);
+    HOST_CHECK(root.Wait(5000U));
+    HOST_CHECK(g_leaves.load() == 64);
+
+    HOST_CHECK(g_pool.Stop());
+    HOST_CHECK(g_pool.Start());
+    std::atomic<int> ran{0};
+    HOST_CHECK(g_pool.Submit([&ran]() { ran.fetch_add(1); }, 100U).Wait(1000U));
+    HOST_CHECK(ran.load() == 1);
+}
+
+/// The owner pushes and pops at the bottom while three thieves steal from
+/// the top; every item must come out exactly once.
+void StressDeque(uint32_t seconds)
+{
+    constexpr uint16_t kItems = 4096U;
+    static WorkStealingDeque<64> deque;
+    static std::atomic<uint8_t> taken[kItems];
+    std::atomic<bool> stop{false};
+    std::atomic<bool> duplicate{false};
+    std::atomic<uint32_t> stolen{0};
+
+    auto take = [&](uint16_t item) {
+        if (taken[item].exchange(1U) != 0U) duplicate.store(true);
+    };
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; ++i) {
+        thieves.emplace_back([&]() {
+            uint16_t item;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (deque.Steal(item)) {
+                    take(item);
+                    stolen.fetch_add(1U, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    uint32_t rounds = 0;
+    const uint64_t endUs = host_test::NowUs() + static_cast<uint64_t>(seconds) * 1000000ULL;
+    while (host_test::NowUs() < endUs) {
+        for (auto& flag : taken) flag.store(0U, std::memory_order_relaxed);
+        uint32_t before = stolen.load();
+        uint32_t popped = 0;
+        for (uint16_t next = 0; next < kItems;) {
+            if (deque.Push(next)) {
+                ++next;
+            }
+            uint16_t item;
+            if ((next & 3U) == 0U && deque.Pop(item)) {
+                take(item);
+                ++popped;
+            }
+        }
+        uint16_t item;
+        while (deque.Pop(item)) {
+            take(item);
+            ++popped;
+        }
+        /// Thieves may still be finishing a steal they won; wait for the count to settle.
+        uint32_t total = 0;
+        for (int spin = 0; spin < 1000; ++spin) {
+            total = popped + (stolen.load() - before);
+            if (total == kItems) break;
+            (void)os_thread_sleep(1U);
+        }
+        HOST_CHECK(total == kItems);
+        ++rounds;
+    }
+    stop.store(true);
+    for (std::thread& thief : thieves) {
+        thief.join();
+    }
+    HOST_CHECK(!duplicate.load());
+    HOST_CHECK(rounds > 0U);
+}
+
+} // namespace
+
+int main()
+{
+    HOST_CHECK(g_pool.Start());
+    TestSubmitAndWait();
+    TestSlotExhaustion();
+    TestForkJoinAndRestart();
+    HOST_CHECK(g_pool.Stop());
+    StressDeque(host_test::StressSeconds(2U));
+    return host_test::Finish("test_thread_pool");
+}